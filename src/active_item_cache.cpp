@@ -1,43 +1,63 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "debug.h"
 #include "item.h"
 
-void active_item_cache::remove( std::list<item>::iterator it, point location )
+active_item_type active_item_cache::type_of( const item &it )
 {
-    const auto predicate = [&]( const item_reference & active_item ) {
-        return location == active_item.location && active_item.item_iterator == it;
-    };
-    // The iterator is expected to be in this list, as it was added that way in `add`.
-    // But the processing_speed may have changed, so if it's not in the expected container,
-    // remove it from all containers to ensure no stale iterator remains.
-    auto &expected = active_items[it->processing_speed()];
-    const auto iter = std::find_if( expected.begin(), expected.end(), predicate );
-    if( iter != expected.end() ) {
-        expected.erase( iter );
-    } else {
-        for( auto &e : active_items ) {
-            e.second.remove_if( predicate );
-        }
+    if( it.is_corpse() ) {
+        return active_item_type::corpse;
+    } else if( it.is_food() || it.is_food_container() ) {
+        return active_item_type::food;
+    } else if( it.is_tool() ) {
+        return active_item_type::tool;
     }
-    if( active_item_set.erase( &*it ) == 0 ) {
-        // map erase returns number of elements erased
+    return active_item_type::misc;
+}
+
+unsigned long long active_item_cache::next_stamp()
+{
+    static std::atomic<unsigned long long> last_stamp( 0 );
+    return ++last_stamp;
+}
+
+void active_item_cache::remove( item_list::iterator it, point )
+{
+    const auto found = active_item_set.find( &*it );
+    if( found == active_item_set.end() ) {
         debugmsg( "The item isn't there!" );
+        return;
+    }
+    const queue_slot slot = found->second;
+    active_item_set.erase( found );
+    current_stamp = next_stamp();
+
+    queue &q = get_queue( slot.type );
+    q.items[slot.index].item_id = nullptr;
+    q.live--;
+    if( q.items.size() > 2 * q.live ) {
+        compact( slot.type );
     }
 }
 
-void active_item_cache::add( std::list<item>::iterator it, point location )
+void active_item_cache::add( item_list::iterator it, point location )
 {
     if( has( it, location ) ) {
         return;
     }
-    active_items[it->processing_speed()].push_back( item_reference{ location, it, &*it } );
-    active_item_set[ &*it ] = false;
+    const active_item_type type = type_of( *it );
+    queue &q = get_queue( type );
+    q.processing_speed = it->processing_speed();
+    active_item_set[ &*it ] = queue_slot{ type, q.items.size(), false };
+    q.items.push_back( item_reference{ location, it, &*it } );
+    q.live++;
+    current_stamp = next_stamp();
 }
 
-bool active_item_cache::has( std::list<item>::iterator it, point ) const
+bool active_item_cache::has( item_list::iterator it, point ) const
 {
     return active_item_set.find( &*it ) != active_item_set.end();
 }
@@ -45,41 +65,84 @@ bool active_item_cache::has( std::list<item>::iterator it, point ) const
 bool active_item_cache::has( const item_reference &itm ) const
 {
     const auto found = active_item_set.find( itm.item_id );
-    return found != active_item_set.end() && found->second;
+    return found != active_item_set.end() && found->second.returned;
 }
 
 bool active_item_cache::empty() const
 {
-    return active_items.empty();
+    return active_item_set.empty();
 }
 
-// get() only returns the first size() / processing_speed() elements of each list, rounded up.
-// It relies on the processing logic to remove and reinsert the items to they
-// move to the back of their respective lists (or to new lists).
-// Otherwise only the first n items will ever be processed.
-std::list<item_reference> active_item_cache::get()
+void active_item_cache::compact( const active_item_type type )
 {
-    std::list<item_reference> items_to_process;
-    for( auto &tuple : active_items ) {
+    queue &q = get_queue( type );
+    size_t dest = 0;
+    size_t next = 0;
+    for( size_t i = 0; i < q.items.size(); ++i ) {
+        if( i == q.next ) {
+            next = dest;
+        }
+        if( q.items[i].item_id == nullptr ) {
+            continue;
+        }
+        active_item_set[q.items[i].item_id].index = dest;
+        q.items[dest++] = q.items[i];
+    }
+    q.items.resize( dest );
+    q.next = next < dest ? next : 0;
+}
+
+// get() only returns the first size() / processing_speed() elements of each queue, rounded up,
+// starting after the last element returned by the previous call.
+// Items that are removed and re-added while being processed (see map.cpp process_item)
+// move to the back of their queue, which keeps the order round robin.
+std::vector<item_reference> active_item_cache::get()
+{
+    std::vector<item_reference> items_to_process;
+    items_to_process.reserve( active_item_set.size() );
+    for( queue &q : queues ) {
+        if( q.live == 0 ) {
+            continue;
+        }
         // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = tuple.second.size() / tuple.first;
-        for( auto &an_iter : tuple.second ) {
-            active_item_set[an_iter.item_id] = true;
-            items_to_process.push_back( an_iter );
-            if( --num_to_process < 0 ) {
-                break;
+        size_t num_to_process = std::min( q.live, q.live / q.processing_speed + 1 );
+        size_t i = q.next < q.items.size() ? q.next : 0;
+        while( num_to_process > 0 ) {
+            const item_reference &ref = q.items[i];
+            if( ref.item_id != nullptr ) {
+                active_item_set[ref.item_id].returned = true;
+                items_to_process.push_back( ref );
+                num_to_process--;
+            }
+            if( ++i == q.items.size() ) {
+                i = 0;
             }
         }
+        q.next = i;
     }
     return items_to_process;
 }
 
+std::vector<item_reference> active_item_cache::get_all() const
+{
+    std::vector<item_reference> result;
+    result.reserve( active_item_set.size() );
+    for( const queue &q : queues ) {
+        for( const item_reference &ref : q.items ) {
+            if( ref.item_id != nullptr ) {
+                result.push_back( ref );
+            }
+        }
+    }
+    return result;
+}
+
 void active_item_cache::subtract_locations( const point &delta )
 {
-    for( auto &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
+    current_stamp = next_stamp();
+    for( queue &q : queues ) {
+        for( item_reference &ir : q.items ) {
             ir.location -= delta;
         }
     }
 }
-
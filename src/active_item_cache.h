@@ -2,40 +2,98 @@
 #ifndef ACTIVE_ITEM_CACHE_H
 #define ACTIVE_ITEM_CACHE_H
 
-#include <list>
+#include <array>
 #include <unordered_map>
+#include <vector>
 
 #include "enums.h"
+#include "item_arena.h"
 
 class item;
 
 // A struct used to uniquely identify an item within a submap or vehicle.
 struct item_reference {
     point location;
-    std::list<item>::iterator item_iterator;
+    item_list::iterator item_iterator;
     // Do not access this from outside this module, it is only used as an ID for active_item_set.
     item *item_id;
 };
 
+/**
+ * Kinds of active item processing. Items of one kind are processed at the same
+ * speed, so they are queued and handed out for processing together.
+ */
+enum class active_item_type : int {
+    food,       // Food and food containers, only need rot and temperature updates
+    corpse,     // Rot, and may revive or be butchered by the environment
+    tool,       // Lit, counting down or otherwise using up charges
+    misc,       // Everything else, e.g. wet items drying up
+    num_active_item_types
+};
+
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
+        /**
+         * Items of one kind in the order they are to be processed.
+         * Removed items leave a hole (item_id == nullptr) so that the round robin
+         * order and the indices of the other items stay stable; holes are compacted
+         * away once they outnumber the live items.
+         */
+        struct queue {
+            std::vector<item_reference> items;
+            // Index into items where the next call to get() continues
+            size_t next = 0;
+            size_t live = 0;
+            int processing_speed = 1;
+        };
+        struct queue_slot {
+            active_item_type type;
+            size_t index;
+            // Whether the item has been returned by get() since it was added
+            bool returned;
+        };
+        std::array<queue, static_cast<size_t>( active_item_type::num_active_item_types )> queues;
         // Cache for fast lookup when we're iterating over the active items to verify the item is present.
-        // Key is item_id, value is whether it was returned in the last call to get
-        std::unordered_map<item *, bool> active_item_set;
+        // Key is item_id, value is where in the queues the item is.
+        std::unordered_map<item *, queue_slot> active_item_set;
+        // See stamp()
+        unsigned long long current_stamp = next_stamp();
+
+        static unsigned long long next_stamp();
+
+        static active_item_type type_of( const item &it );
+        queue &get_queue( active_item_type type ) {
+            return queues[static_cast<size_t>( type )];
+        }
+        void compact( active_item_type type );
 
     public:
-        void remove( std::list<item>::iterator it, point location );
-        void add( std::list<item>::iterator it, point location );
-        bool has( std::list<item>::iterator it, point ) const;
+        void remove( item_list::iterator it, point );
+        void add( item_list::iterator it, point location );
+        bool has( item_list::iterator it, point ) const;
         // Use this one if there's a chance that the item being referenced has been invalidated.
         bool has( const item_reference &itm ) const;
         bool empty() const;
-        std::list<item_reference> get();
+        /**
+         * Returns the items due for processing this turn, grouped by kind.
+         * Only size() / processing_speed() items of each kind, rounded up, are returned
+         * and the next call continues where this one left off.
+         */
+        std::vector<item_reference> get();
+        /** Returns every active item, without affecting the processing order. */
+        std::vector<item_reference> get_all() const;
 
         /** Subtract delta from every item_reference's location */
         void subtract_locations( const point &delta );
+        /**
+         * Changes whenever items are added or removed or their locations change. No two caches
+         * share a stamp, so a list built from a cache can tell that it is out of date even when
+         * the cache it came from was replaced by another one at the same address.
+         */
+        unsigned long long stamp() const {
+            return current_stamp;
+        }
 };
 
 #endif
@@ -2,7 +2,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <list>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "action.h"
@@ -988,6 +991,64 @@ std::vector<tripoint> route_adjacent( const player &p, const tripoint &dest )
     return std::vector<tripoint>();
 }
 
+namespace
+{
+
+/**
+ * What sorting out loot from one place works out, kept between the turns of the activity until
+ * the sorter moves or the zones change.
+ */
+struct loot_sort_plan {
+    tripoint origin = tripoint_min;
+    int zone_revision = -1;
+    // Absolute squares of the unsorted zones in reach, nearest first
+    std::vector<tripoint> sources;
+    // Sources outside of the reality bubble no route could be found to
+    std::set<tripoint> unreachable;
+    // Destination zone type of an item on the ground, along with what the zone depends on that
+    // can change without adding or removing items: the contents and the rot.
+    struct classified_item {
+        zone_type_id destination;
+        itype_id contents_type;
+        bool rotten;
+
+        classified_item( const item &it, const zone_type_id &dest ) :
+            destination( dest ), contents_type( contents_type_of( it ) ),
+            rotten( it.rotten() ) {}
+
+        bool still_matches( const item &it ) const {
+            return contents_type == contents_type_of( it ) && rotten == it.rotten();
+        }
+
+        static itype_id contents_type_of( const item &it ) {
+            return it.contents.empty() ? "null" : it.contents.front().typeId();
+        }
+    };
+    // Destinations of the items on the ground of a source, in item order.
+    // Only valid while nothing is added to or removed from the square, see map::item_stamp.
+    struct classified_items {
+        uint64_t item_stamp;
+        std::vector<cata::optional<classified_item>> destinations;
+    };
+    std::unordered_map<tripoint, classified_items> classified;
+};
+
+} // namespace
+
+static loot_sort_plan &plan_loot_sort( const tripoint &abspos )
+{
+    static loot_sort_plan plan;
+    const zone_manager &mgr = zone_manager::get_manager();
+    if( plan.origin != abspos || plan.zone_revision != mgr.get_revision() ) {
+        plan = loot_sort_plan();
+        plan.origin = abspos;
+        plan.zone_revision = mgr.get_revision();
+        plan.sources = get_sorted_tiles_by_distance( abspos,
+                       mgr.get_near( zone_type_id( "LOOT_UNSORTED" ), abspos ) );
+    }
+    return plan;
+}
+
 void activity_on_turn_move_loot( player_activity &, player &p )
 {
     const activity_id act_move_loot = activity_id( "ACT_MOVE_LOOT" );
@@ -996,15 +1057,15 @@ void activity_on_turn_move_loot( player_activity &, player &p )
         mgr.cache_vzones();
     }
     const auto abspos = g->m.getabs( p.pos() );
-    const auto &src_set = mgr.get_near( zone_type_id( "LOOT_UNSORTED" ), abspos );
-    vehicle *src_veh, *dest_veh;
-    int src_part, dest_part;
+    loot_sort_plan &plan = plan_loot_sort( abspos );
+    vehicle *src_veh;
+    int src_part;
 
     // Nuke the current activity, leaving the backlog alone.
     p.activity = player_activity();
 
-    // sort source tiles by distance
-    const auto &src_sorted = get_sorted_tiles_by_distance( abspos, src_set );
+    // source tiles sorted by distance
+    const std::vector<tripoint> &src_sorted = plan.sources;
 
     if( !mgr.is_sorting() ) {
         mgr.start_sort( src_sorted );
@@ -1022,11 +1083,15 @@ void activity_on_turn_move_loot( player_activity &, player &p )
                 mgr.end_sort();
                 return;
             }
+            if( plan.unreachable.count( src ) != 0 ) {
+                continue;
+            }
             std::vector<tripoint> route;
             route = g->m.route( p.pos(), src_loc, p.get_pathfinding_settings(),
                                 p.get_path_avoid() );
             if( route.empty() ) {
                 // can't get there, can't do anything, skip it
+                plan.unreachable.insert( src );
                 continue;
             }
             p.set_destination( route, player_activity( act_move_loot ) );
@@ -1068,93 +1133,110 @@ void activity_on_turn_move_loot( player_activity &, player &p )
                 }
             }
         }
+        // Items on the ground keep their classification for as long as they stay the same
+        loot_sort_plan::classified_items *classes = nullptr;
+        if( src_veh == nullptr ) {
+            const uint64_t stamp = g->m.item_stamp( src_loc );
+            classes = &plan.classified[src];
+            if( classes->item_stamp != stamp || classes->destinations.size() != items.size() ) {
+                classes->item_stamp = stamp;
+                classes->destinations.assign( items.size(), cata::nullopt );
+            }
+        }
+
         //Skip items that have already been processed
         for( auto it = items.begin() + mgr.get_num_processed( src ); it < items.end(); it++ ) {
 
             mgr.increment_num_processed( src );
 
-            const auto id = mgr.get_near_zone_type_for_item( **it, abspos );
+            zone_type_id id;
+            cata::optional<loot_sort_plan::classified_item> *const known = classes != nullptr ?
+                    &classes->destinations[it - items.begin()] : nullptr;
+            if( known != nullptr && *known && ( *known )->still_matches( **it ) ) {
+                id = ( *known )->destination;
+            } else {
+                id = mgr.get_near_zone_type_for_item( **it, abspos );
+                if( known != nullptr ) {
+                    known->emplace( **it, id );
+                }
+            }
 
             // checks whether the item is already on correct loot zone or not
             // if it is, we can skip such item, if not we move the item to correct pile
             // think empty bag on food pile, after you ate the content
             if( !mgr.has( id, src ) ) {
-                const auto &dest_set = mgr.get_near( id, abspos );
-
-                for( auto &dest : dest_set ) {
-                    const auto &dest_loc = g->m.getlocal( dest );
-
-                    //Check destination for cargo part
-                    if( const cata::optional<vpart_reference> vp = g->m.veh_at( dest_loc ).part_with_feature( "CARGO",
-                            false ) ) {
-                        dest_veh = &vp->vehicle();
-                        dest_part = vp->part_index();
-                    } else {
-                        dest_veh = nullptr;
-                        dest_part = -1;
-                    }
+                // Destinations are looked at lazily, the first one with room for the item wins
+                cata::optional<tripoint> dest_loc;
+                mgr.visit_near( id, abspos, [&dest_loc, it]( const tripoint & dest ) {
+                    const tripoint loc = g->m.getlocal( dest );
 
                     // skip tiles with inaccessible furniture, like filled charcoal kiln
-                    if( !g->m.can_put_items_ter_furn( dest_loc ) ) {
-                        continue;
+                    if( !g->m.can_put_items_ter_furn( loc ) ) {
+                        return true;
                     }
 
                     units::volume free_space;
                     // if there's a vehicle with space do not check the tile beneath
-                    if( dest_veh ) {
-                        free_space = dest_veh->free_volume( dest_part );
+                    //Check destination for cargo part
+                    const cata::optional<vpart_reference> vp =
+                        g->m.veh_at( loc ).part_with_feature( "CARGO", false );
+                    if( vp ) {
+                        free_space = vp->vehicle().free_volume( vp->part_index() );
                     } else {
-                        free_space = g->m.free_volume( dest_loc );
+                        free_space = g->m.free_volume( loc );
                     }
                     // check free space at destination
                     if( free_space >= ( *it )->volume() ) {
-                        // before we move any item, check if player is at or
-                        // adjacent to the loot source tile
-                        if( !is_adjacent_or_closer ) {
-                            std::vector<tripoint> route;
-                            bool adjacent = false;
-
-                            // get either direct route or route to nearest adjacent tile if
-                            // source tile is impassable
-                            if( g->m.passable( src_loc ) ) {
-                                route = g->m.route( p.pos(), src_loc, p.get_pathfinding_settings(),
-                                                    p.get_path_avoid() );
-                            } else {
-                                // immpassable source tile (locker etc.),
-                                // get route to nerest adjacent tile instead
-                                route = route_adjacent( p, src_loc );
-                                adjacent = true;
-                            }
-
-                            // check if we found path to source / adjacent tile
-                            if( route.empty() ) {
-                                add_msg( m_info, _( "%s can't reach the source tile. Try to sort out loot without a cart." ),
-                                         p.disp_name() );
-                                mgr.end_sort();
-                                return;
-                            }
-
-                            // shorten the route to adjacent tile, if necessary
-                            if( !adjacent ) {
-                                route.pop_back();
-                            }
-
-                            // set the destination and restart activity after player arrives there
-                            // we don't need to check for safe mode,
-                            // activity will be restarted only if
-                            // player arrives on destination tile
-                            p.set_destination( route, player_activity( act_move_loot ) );
+                        dest_loc = loc;
+                        return false;
+                    }
+                    return true;
+                } );
+
+                if( dest_loc ) {
+                    // before we move any item, check if player is at or
+                    // adjacent to the loot source tile
+                    if( !is_adjacent_or_closer ) {
+                        std::vector<tripoint> route;
+                        bool adjacent = false;
+
+                        // get either direct route or route to nearest adjacent tile if
+                        // source tile is impassable
+                        if( g->m.passable( src_loc ) ) {
+                            route = g->m.route( p.pos(), src_loc, p.get_pathfinding_settings(),
+                                                p.get_path_avoid() );
+                        } else {
+                            // immpassable source tile (locker etc.),
+                            // get route to nerest adjacent tile instead
+                            route = route_adjacent( p, src_loc );
+                            adjacent = true;
+                        }
+
+                        // check if we found path to source / adjacent tile
+                        if( route.empty() ) {
+                            add_msg( m_info, _( "%s can't reach the source tile. Try to sort out loot without a cart." ),
+                                     p.disp_name() );
                             mgr.end_sort();
                             return;
                         }
-                        move_item( p, **it, ( *it )->count(), src_loc, dest_loc, src_veh,
-                                   src_part );
 
-                        // moved item away from source so decrement
-                        mgr.decrement_num_processed( src );
+                        // shorten the route to adjacent tile, if necessary
+                        if( !adjacent ) {
+                            route.pop_back();
+                        }
 
-                        break;
+                        // set the destination and restart activity after player arrives there
+                        // we don't need to check for safe mode,
+                        // activity will be restarted only if
+                        // player arrives on destination tile
+                        p.set_destination( route, player_activity( act_move_loot ) );
+                        mgr.end_sort();
+                        return;
                     }
+                    move_item( p, **it, ( *it )->count(), src_loc, *dest_loc, src_veh, src_part );
+
+                    // moved item away from source so decrement
+                    mgr.decrement_num_processed( src );
                 }
                 if( p.moves <= 0 ) {
                     // Restart activity and break from cycle.
@@ -1367,7 +1367,7 @@ bool advanced_inventory::move_all_items( bool nested_call )
         }
         g->u.activity.placement = sarea.off;
 
-        std::list<item>::iterator begin, end;
+        item_stack::iterator begin, end;
         if( panes[src].in_vehicle() ) {
             begin = sarea.veh->get_items( sarea.vstor ).begin();
             end = sarea.veh->get_items( sarea.vstor ).end();
@@ -1746,7 +1746,7 @@ void advanced_inventory::display()
                 }
                 g->u.activity.placement = squares[srcarea].off;
 
-                std::list<item>::iterator begin, end;
+                item_stack::iterator begin, end;
                 if( from_vehicle ) {
                     begin = squares[srcarea].veh->get_items( squares[srcarea].vstor ).begin();
                     end = squares[srcarea].veh->get_items( squares[srcarea].vstor ).end();
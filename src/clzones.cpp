@@ -1,5 +1,7 @@
 #include "clzones.h"
 
+#include <climits>
+
 #include "cata_utility.h"
 #include "debug.h"
 #include "game.h"
@@ -356,107 +358,138 @@ bool zone_manager::has_type( const zone_type_id &type ) const
     return types.count( type ) > 0;
 }
 
-void zone_manager::cache_data()
+point zone_box_index::cell_of( const int x, const int y )
 {
-    area_cache.clear();
-
-    for( auto &elem : zones ) {
-        if( !elem.get_enabled() ) {
-            continue;
-        }
-
-        const zone_type_id &type = elem.get_type();
-        auto &cache = area_cache[type];
+    // Round towards negative infinity, absolute coordinates can be negative
+    const auto div = []( const int v ) {
+        return v >= 0 ? v / cell_size : ( v - cell_size + 1 ) / cell_size;
+    };
+    return point( div( x ), div( y ) );
+}
 
-        tripoint start = elem.get_start_point();
-        tripoint end = elem.get_end_point();
+void zone_box_index::clear()
+{
+    boxes.clear();
+    cells.clear();
+}
 
-        // Draw marked area
-        for( int x = start.x; x <= end.x; ++x ) {
-            for( int y = start.y; y <= end.y; ++y ) {
-                for( int z = start.z; z <= end.z; ++z ) {
-                    cache.insert( tripoint( x, y, z ) );
-                }
-            }
+void zone_box_index::add( const tripoint &start, const tripoint &end )
+{
+    const size_t index = boxes.size();
+    boxes.push_back( box{ start, end } );
+    const point first = cell_of( start.x, start.y );
+    const point last = cell_of( end.x, end.y );
+    for( int x = first.x; x <= last.x; x++ ) {
+        for( int y = first.y; y <= last.y; y++ ) {
+            cells[point( x, y )].push_back( index );
         }
     }
 }
 
-void zone_manager::cache_vzones()
+std::vector<size_t> zone_box_index::boxes_near( const tripoint &p, const int radius ) const
 {
-    vzone_cache.clear();
-    auto vzones = g->m.get_vehicle_zones( g->get_levz() );
-    for( auto elem : vzones ) {
-        if( !elem->get_enabled() ) {
-            continue;
-        }
-
-        const zone_type_id &type = elem->get_type();
-        auto &cache = vzone_cache[type];
-
-        tripoint start = elem->get_start_point();
-        tripoint end = elem->get_end_point();
-
-        // Draw marked area
-        for( int x = start.x; x <= end.x; ++x ) {
-            for( int y = start.y; y <= end.y; ++y ) {
-                for( int z = start.z; z <= end.z; ++z ) {
-                    cache.insert( tripoint( x, y, z ) );
+    std::vector<size_t> result;
+    const point first = cell_of( p.x - radius, p.y - radius );
+    const point last = cell_of( p.x + radius, p.y + radius );
+    for( int x = first.x; x <= last.x; x++ ) {
+        for( int y = first.y; y <= last.y; y++ ) {
+            const auto cell = cells.find( point( x, y ) );
+            if( cell == cells.end() ) {
+                continue;
+            }
+            for( const size_t i : cell->second ) {
+                const box &b = boxes[i];
+                if( b.start.z <= p.z && p.z <= b.end.z &&
+                    b.start.x <= p.x + radius && p.x - radius <= b.end.x &&
+                    b.start.y <= p.y + radius && p.y - radius <= b.end.y ) {
+                    result.push_back( i );
                 }
             }
         }
     }
+    // Boxes spanning several cells were found more than once
+    std::sort( result.begin(), result.end() );
+    result.erase( std::unique( result.begin(), result.end() ), result.end() );
+    return result;
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type ) const
+bool zone_box_index::contains( const tripoint &p ) const
 {
-    const auto &type_iter = area_cache.find( type );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
+    const auto cell = cells.find( cell_of( p.x, p.y ) );
+    if( cell == cells.end() ) {
+        return false;
     }
+    return std::any_of( cell->second.begin(), cell->second.end(), [this, &p]( const size_t i ) {
+        return boxes[i].contains( p );
+    } );
+}
 
-    return type_iter->second;
+bool zone_box_index::has_near( const tripoint &p, const int radius ) const
+{
+    return !boxes_near( p, radius ).empty();
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type ) const
+cata::optional<tripoint> zone_box_index::nearest( const tripoint &p, const int radius ) const
 {
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( type );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
+    cata::optional<tripoint> result;
+    int best = INT_MAX;
+    for( const size_t i : boxes_near( p, radius ) ) {
+        const box &b = boxes[i];
+        // The square of a box closest to p is p moved into the box
+        const tripoint q( clamp( p.x, b.start.x, b.end.x ), clamp( p.y, b.start.y, b.end.y ), p.z );
+        const int dist = square_dist( p, q );
+        if( dist < best ) {
+            best = dist;
+            result = q;
+        }
     }
-
-    return type_iter->second;
+    return result;
 }
 
-bool zone_manager::has( const zone_type_id &type, const tripoint &where ) const
+void zone_manager::cache_data()
 {
-    const auto &point_set = get_point_set( type );
-    const auto &vzone_set = get_vzone_set( type );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    area_cache.clear();
+    revision++;
+
+    for( auto &elem : zones ) {
+        if( !elem.get_enabled() ) {
+            continue;
+        }
+        area_cache[elem.get_type()].add( elem.get_start_point(), elem.get_end_point() );
+    }
 }
 
-bool zone_manager::has_near( const zone_type_id &type, const tripoint &where ) const
+void zone_manager::cache_vzones()
 {
-    const auto &point_set = get_point_set( type );
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= MAX_DISTANCE ) {
-                return true;
-            }
+    vzone_cache.clear();
+    revision++;
+    auto vzones = g->m.get_vehicle_zones( g->get_levz() );
+    for( auto elem : vzones ) {
+        if( !elem->get_enabled() ) {
+            continue;
         }
+        vzone_cache[elem->get_type()].add( elem->get_start_point(), elem->get_end_point() );
     }
+}
 
-    const auto &vzone_set = get_vzone_set( type );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= MAX_DISTANCE ) {
-                return true;
-            }
-        }
+bool zone_manager::has( const zone_type_id &type, const tripoint &where ) const
+{
+    const auto area = area_cache.find( type );
+    if( area != area_cache.end() && area->second.contains( where ) ) {
+        return true;
     }
+    const auto vzone = vzone_cache.find( type );
+    return vzone != vzone_cache.end() && vzone->second.contains( where );
+}
 
-    return false;
+bool zone_manager::has_near( const zone_type_id &type, const tripoint &where ) const
+{
+    const auto area = area_cache.find( type );
+    if( area != area_cache.end() && area->second.has_near( where, MAX_DISTANCE ) ) {
+        return true;
+    }
+    const auto vzone = vzone_cache.find( type );
+    return vzone != vzone_cache.end() && vzone->second.has_near( where, MAX_DISTANCE );
 }
 
 bool zone_manager::has_loot_dest_near( const tripoint &where ) const
@@ -478,27 +511,31 @@ bool zone_manager::has_loot_dest_near( const tripoint &where ) const
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where ) const
 {
-    const auto &point_set = get_point_set( type );
     auto near_point_set = std::unordered_set<tripoint>();
+    visit_near( type, where, [&near_point_set]( const tripoint & p ) {
+        near_point_set.insert( p );
+        return true;
+    } );
+    return near_point_set;
+}
 
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= MAX_DISTANCE ) {
-                near_point_set.insert( point );
-            }
-        }
-    }
-
-    const auto &vzone_set = get_vzone_set( type );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= MAX_DISTANCE ) {
-                near_point_set.insert( point );
-            }
+cata::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type,
+        const tripoint &where ) const
+{
+    cata::optional<tripoint> result;
+    const auto area = area_cache.find( type );
+    if( area != area_cache.end() ) {
+        result = area->second.nearest( where, MAX_DISTANCE );
+    }
+    const auto vzone = vzone_cache.find( type );
+    if( vzone != vzone_cache.end() ) {
+        const cata::optional<tripoint> vehicle = vzone->second.nearest( where, MAX_DISTANCE );
+        if( vehicle && ( !result ||
+                         square_dist( where, *vehicle ) < square_dist( where, *result ) ) ) {
+            result = vehicle;
         }
     }
-
-    return near_point_set;
+    return result;
 }
 
 zone_type_id zone_manager::get_near_zone_type_for_item( const item &it,
@@ -2,6 +2,7 @@
 #ifndef CLZONES_H
 #define CLZONES_H
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -210,6 +211,74 @@ class zone_data
         void deserialize( JsonIn &jsin );
 };
 
+/**
+ * Boxes of zone squares, bucketed by the grid cells they overlap, so that looking for zones at or
+ * around a point only checks the boxes nearby instead of every square of every zone.
+ * Uses absolute map square coordinates.
+ */
+class zone_box_index
+{
+    public:
+        void clear();
+        void add( const tripoint &start, const tripoint &end );
+        bool empty() const {
+            return boxes.empty();
+        }
+        /** Whether any box contains p. */
+        bool contains( const tripoint &p ) const;
+        /** Whether any box has a square on p.z within square distance radius of p. */
+        bool has_near( const tripoint &p, int radius ) const;
+        /**
+         * The square on p.z within square distance radius of p that is in any box and closest
+         * to p by square distance, ties going to the box added first.
+         */
+        cata::optional<tripoint> nearest( const tripoint &p, int radius ) const;
+        /**
+         * Calls func with each square on p.z within square distance radius of p that is in any
+         * box, every square once. Stops early when func returns false.
+         */
+        template<typename Func>
+        void visit_near( const tripoint &p, int radius, Func func ) const {
+            const std::vector<size_t> near = boxes_near( p, radius );
+            // Squares where boxes overlap are only visited for the first of them
+            std::unordered_set<tripoint> visited;
+            const bool may_overlap = near.size() > 1;
+            for( const size_t i : near ) {
+                const box &b = boxes[i];
+                const int max_x = std::min( b.end.x, p.x + radius );
+                const int max_y = std::min( b.end.y, p.y + radius );
+                for( int x = std::max( b.start.x, p.x - radius ); x <= max_x; x++ ) {
+                    for( int y = std::max( b.start.y, p.y - radius ); y <= max_y; y++ ) {
+                        const tripoint q( x, y, p.z );
+                        if( may_overlap && !visited.insert( q ).second ) {
+                            continue;
+                        }
+                        if( !func( q ) ) {
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        struct box {
+            tripoint start;
+            tripoint end;
+            bool contains( const tripoint &p ) const {
+                return p.x >= start.x && p.x <= end.x && p.y >= start.y && p.y <= end.y &&
+                       p.z >= start.z && p.z <= end.z;
+            }
+        };
+        static constexpr int cell_size = 32;
+        static point cell_of( int x, int y );
+        /** Indices of the boxes reaching p.z and within square distance radius of p, sorted. */
+        std::vector<size_t> boxes_near( const tripoint &p, int radius ) const;
+
+        std::vector<box> boxes;
+        std::unordered_map<point, std::vector<size_t>> cells;
+};
+
 class zone_manager
 {
     public:
@@ -228,10 +297,10 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<zone_type_id, std::unordered_set<tripoint>> area_cache;
-        std::unordered_map<zone_type_id, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type ) const;
+        std::unordered_map<zone_type_id, zone_box_index> area_cache;
+        std::unordered_map<zone_type_id, zone_box_index> vzone_cache;
+        // Bumped whenever the caches above are rebuilt
+        int revision = 0;
 
         //Cache number of items already checked on each source tile when sorting
         std::unordered_map<tripoint, int> num_processed;
@@ -269,10 +338,38 @@ class zone_manager
         bool has_type( const zone_type_id &type ) const;
         void cache_data();
         void cache_vzones();
+        /** Changes whenever the cached zones do, anything computed from them is good until then. */
+        int get_revision() const {
+            return revision;
+        }
         bool has( const zone_type_id &type, const tripoint &where ) const;
         bool has_near( const zone_type_id &type, const tripoint &where ) const;
         bool has_loot_dest_near( const tripoint &where ) const;
         std::unordered_set<tripoint> get_near( const zone_type_id &type, const tripoint &where ) const;
+        /** The square of the given zone type near where that is closest to it, see get_near. */
+        cata::optional<tripoint> get_nearest( const zone_type_id &type,
+                                              const tripoint &where ) const;
+        /**
+         * Calls func with each square of the given zone type near where, see get_near.
+         * Squares in both a regular and a vehicle zone come up twice.
+         * Stops early when func returns false.
+         */
+        template<typename Func>
+        void visit_near( const zone_type_id &type, const tripoint &where, Func func ) const {
+            bool done = false;
+            const auto visit = [&func, &done]( const tripoint & p ) {
+                done = !func( p );
+                return !done;
+            };
+            const auto area = area_cache.find( type );
+            if( area != area_cache.end() ) {
+                area->second.visit_near( where, MAX_DISTANCE, visit );
+            }
+            const auto vzone = vzone_cache.find( type );
+            if( !done && vzone != vzone_cache.end() ) {
+                vzone->second.visit_near( where, MAX_DISTANCE, visit );
+            }
+        }
         zone_type_id get_near_zone_type_for_item( const item &it, const tripoint &where ) const;
         std::vector<zone_data> get_zones( const zone_type_id &type, const tripoint &where ) const;
         const zone_data *get_bottom_zone( const tripoint &where ) const;
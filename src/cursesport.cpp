@@ -27,6 +27,28 @@
  * must not contain a two cell width string.
  */
 
+void cata_cursesport::cursecell::set( const char *ch, int len )
+{
+    if( len > max_bytes ) {
+        // Cut before the code point that doesn't fit any more
+        len = max_bytes;
+        while( len > 0 && ( static_cast<unsigned char>( ch[len] ) & 0xC0 ) == 0x80 ) {
+            len--;
+        }
+    }
+    std::copy( ch, ch + len, bytes );
+    size = len;
+    if( len == 0 ) {
+        width = 0;
+        codepoint = 0;
+        return;
+    }
+    const char *tmpptr = ch;
+    int tmplen = len;
+    codepoint = UTF8_getch( &tmpptr, &tmplen );
+    width = codepoint == UNKNOWN_UNICODE ? 1 : utf8_width( str() );
+}
+
 //***********************************
 //Globals                           *
 //***********************************
@@ -260,7 +282,7 @@ void catacurses::wredrawln( const window &/*win*/, int /*beg_line*/, int /*num_l
 
 // Get a sequence of Unicode code points, store them in target
 // return the display width of the extracted string.
-inline int fill( const char *&fmt, int &len, std::string &target )
+inline int fill( const char *&fmt, int &len, cata_cursesport::cursecell &target )
 {
     const char *const start = fmt;
     int dlen = 0; // display width
@@ -277,7 +299,7 @@ inline int fill( const char *&fmt, int &len, std::string &target )
             // First char is a control character: they only disturb the screen,
             // so replace it with a single space (e.g. instead of a '\t').
             // Newlines at the begin of a sequence are handled in printstring
-            target.assign( " ", 1 );
+            target.set( " ", 1 );
             len = tmplen;
             fmt = tmpptr;
             return 1; // the space
@@ -290,8 +312,8 @@ inline int fill( const char *&fmt, int &len, std::string &target )
         fmt = tmpptr;
         dlen += cw;
     }
-    target.assign( start, fmt - start );
-    len -= target.length();
+    target.set( start, fmt - start );
+    len -= fmt - start;
     return dlen;
 }
 
@@ -326,9 +348,9 @@ inline void printstring( cata_cursesport::WINDOW *win, const std::string &text )
     if( win->cursory >= win->height || win->cursorx >= win->width ) {
         return;
     }
-    if( win->cursorx > 0 && win->line[win->cursory].chars[win->cursorx].ch.empty() ) {
+    if( win->cursorx > 0 && win->line[win->cursory].chars[win->cursorx].empty() ) {
         // start inside a wide character, erase it for good
-        win->line[win->cursory].chars[win->cursorx - 1].ch.assign( " " );
+        win->line[win->cursory].chars[win->cursorx - 1].set( " ", 1 );
     }
     while( len > 0 ) {
         if( *fmt == '\n' ) {
@@ -343,7 +365,7 @@ inline void printstring( cata_cursesport::WINDOW *win, const std::string &text )
         if( curcell == nullptr ) {
             return;
         }
-        const int dlen = fill( fmt, len, curcell->ch );
+        const int dlen = fill( fmt, len, *curcell );
         if( dlen >= 1 ) {
             curcell->FG = win->FG;
             curcell->BG = win->BG;
@@ -353,8 +375,8 @@ inline void printstring( cata_cursesport::WINDOW *win, const std::string &text )
             // a wide character was converted to a narrow character leaving a null in the
             // following cell ~> clear it
             cursecell *seccell = cur_cell( win );
-            if( seccell && seccell->ch.empty() ) {
-                seccell->ch.assign( ' ', 1 );
+            if( seccell && seccell->empty() ) {
+                seccell->set( " ", 1 );
             }
         } else if( dlen == 2 ) {
             // the second cell, per definition must be empty
@@ -363,25 +385,25 @@ inline void printstring( cata_cursesport::WINDOW *win, const std::string &text )
                 // the previous cell was valid, this one is outside of the window
                 // --> the previous was the last cell of the last line
                 // --> there should not be a two-cell width character in the last cell
-                curcell->ch.assign( ' ', 1 );
+                curcell->set( " ", 1 );
                 return;
             }
             seccell->FG = win->FG;
             seccell->BG = win->BG;
-            seccell->ch.erase();
+            seccell->clear();
             addedchar( win );
             // Have just written a wide-character into the last cell, it would not
             // display correctly if it was the last *cell* of a line
             if( win->cursorx == 1 ) {
                 // So make that last cell a space, move the width
                 // character in the first cell of the line
-                seccell->ch = curcell->ch;
-                curcell->ch.assign( 1, ' ' );
+                *seccell = *curcell;
+                curcell->set( " ", 1 );
                 // and make the second cell on the new line empty.
                 addedchar( win );
                 cursecell *thicell = cur_cell( win );
                 if( thicell != nullptr ) {
-                    thicell->ch.erase();
+                    thicell->clear();
                 }
             }
         }
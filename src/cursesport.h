@@ -4,7 +4,9 @@
 
 #if defined(TILES) || defined(_WIN32)
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -32,16 +34,50 @@ typedef struct {
 } pairs;
 
 //Individual lines, so that we can track changed lines
+/**
+ * One console cell: an UTF-8 encoded character with its colors.
+ * The character is kept inline together with its first code point and display width, so
+ * cells can be copied and compared without touching the heap and the renderers don't have
+ * to decode them on every redraw. Combining characters beyond what fits are dropped.
+ */
 struct cursecell {
-    std::string ch;
+    static constexpr int max_bytes = 11;
+
+    // Empty for the second cell of a wide character
+    char bytes[max_bytes];
+    uint8_t size = 0;
+    int8_t width = 0;
+    uint32_t codepoint = 0;
     base_color FG = static_cast<base_color>( 0 );
     base_color BG = static_cast<base_color>( 0 );
 
-    cursecell( std::string ch ) : ch( std::move( ch ) ) { }
-    cursecell() : cursecell( std::string( 1, ' ' ) ) { }
+    cursecell( const std::string &ch ) {
+        set( ch.c_str(), ch.size() );
+    }
+    cursecell() {
+        set( " ", 1 );
+    }
+
+    /** Sets the character to the first len bytes of ch, keeps the colors. */
+    void set( const char *ch, int len );
+    void clear() {
+        size = 0;
+        width = 0;
+        codepoint = 0;
+    }
+    bool empty() const {
+        return size == 0;
+    }
+    bool is_space() const {
+        return size == 1 && bytes[0] == ' ';
+    }
+    std::string str() const {
+        return std::string( bytes, size );
+    }
 
     bool operator==( const cursecell &b ) const {
-        return FG == b.FG && BG == b.BG && ch == b.ch;
+        return FG == b.FG && BG == b.BG && size == b.size &&
+               std::equal( bytes, bytes + size, b.bytes );
     }
 };
 
@@ -1759,17 +1759,27 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
                         std::memcpy( destsm->trp, srcsm->trp, sizeof( srcsm->trp ) ); // traps
                         std::memcpy( destsm->rad, srcsm->rad, sizeof( srcsm->rad ) ); // radiation
                         std::memcpy( destsm->lum, srcsm->lum, sizeof( srcsm->lum ) ); // emissive items
+                        // Items can't be swapped between the arenas of two submaps, move them over
+                        // and rebuild the active item cache to point at the moved items.
+                        destsm->active_items = active_item_cache();
                         for( int x = 0; x < SEEX; ++x ) {
                             for( int y = 0; y < SEEY; ++y ) {
-                                destsm->itm[x][y].swap( srcsm->itm[x][y] );
+                                item_list &dest_items = destsm->itm[x][y];
+                                dest_items.clear();
+                                destsm->items_changed( point( x, y ) );
+                                for( item &it : srcsm->itm[x][y] ) {
+                                    dest_items.push_back( std::move( it ) );
+                                    if( dest_items.back().needs_processing() ) {
+                                        destsm->active_items.add( std::prev( dest_items.end() ),
+                                                                  point( x, y ) );
+                                    }
+                                }
                             }
                         }
                         // Swap cosmetics vectors
                         destsm->cosmetics.swap( srcsm->cosmetics );
 
                         // various misc variables
-                        destsm->active_items = srcsm->active_items;
-
                         destsm->temperature = srcsm->temperature;
                         destsm->last_touched = calendar::turn;
                         destsm->comp = std::move( srcsm->comp );
@@ -2007,6 +2017,7 @@ void editmap::cleartmpmap( tinymap &tmpmap )
     auto &ch = tmpmap.get_cache( target.z );
     std::memset( ch.veh_exists_at, 0, sizeof( ch.veh_exists_at ) );
     ch.veh_cached_parts.clear();
+    ch.veh_cached_areas.clear();
     ch.vehicle_list.clear();
     ch.zone_vehicles.clear();
 }
@@ -24,8 +24,15 @@
 #include "vehicle.h"
 #include "vpart_position.h"
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <queue>
 #include <random>
+#include <thread>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
 
 static const itype_id null_itype( "null" );
 
@@ -277,7 +284,43 @@ void game::explosion( const tripoint &p, float power, float factor, bool fire,
     explosion( p, data );
 }
 
+namespace
+{
+
+struct queued_explosion {
+    tripoint p;
+    explosion_data ex;
+};
+
+} // namespace
+
+// Explosions waiting to be set off, in the order they were triggered.
+static std::vector<queued_explosion> explosion_queue;
+// While positive, explosions are only queued, see explosion_batch.
+static int explosion_holds = 0;
+
+explosion_batch::explosion_batch()
+{
+    explosion_holds++;
+}
+
+explosion_batch::~explosion_batch()
+{
+    explosion_holds--;
+    if( explosion_holds == 0 && !explosion_queue.empty() ) {
+        g->process_explosions();
+    }
+}
+
 void game::explosion( const tripoint &p, const explosion_data &ex )
+{
+    explosion_queue.push_back( queued_explosion{ p, ex } );
+    if( explosion_holds == 0 ) {
+        process_explosions();
+    }
+}
+
+static void explosion_noise( const tripoint &p, const explosion_data &ex )
 {
     const int noise = ex.power * ( ex.fire ? 2 : 10 );
     if( noise >= 30 ) {
@@ -290,41 +333,30 @@ void game::explosion( const tripoint &p, const explosion_data &ex )
         sounds::sound( p, 3, sounds::sound_t::combat, _( "a loud pop!" ) );
         sfx::play_variant_sound( "explosion", "small", 100 );
     }
+}
 
-    if( ex.distance_factor >= 1.0f ) {
-        debugmsg( "called game::explosion with factor >= 1.0 (infinite size)" );
-    } else if( ex.distance_factor > 0.0f && ex.power > 0.0f ) {
-        // Power rescaled to mean grams of TNT equivalent, this scales it roughly back to where
-        // it was before until we re-do blasting power to be based on TNT-equivalent directly.
-        do_blast( p, ex.power / 15.0, ex.distance_factor, ex.fire );
+static void drop_fragments( const shrapnel_data &shr, const std::vector<tripoint> &locations )
+{
+    if( shr.recovery <= 0 || shr.drop == "null" ) {
+        return;
     }
-
-    const auto &shr = ex.shrapnel;
-    if( shr.casing_mass > 0 ) {
-        auto shrapnel_locations = shrapnel( p, ex.power, shr.casing_mass, shr.fragment_mass );
-
-        // If explosion drops shrapnel...
-        if( shr.recovery > 0 && shr.drop != "null" ) {
-
-            // Extract only passable tiles affected by shrapnel
-            std::vector<tripoint> tiles;
-            for( const auto &e : shrapnel_locations ) {
-                if( g->m.passable( e ) ) {
-                    tiles.push_back( e );
-                }
-            }
-            const itype *fragment_drop = item_controller->find_template( shr.drop );
-            int qty = shr.casing_mass * std::min( 1.0, shr.recovery / 100.0 ) /
-                      to_gram( fragment_drop->weight );
-            // Truncate to a random selection
-            std::shuffle( tiles.begin(), tiles.end(), rng_get_engine() );
-            tiles.resize( std::min( static_cast<int>( tiles.size() ), qty ) );
-
-            for( const auto &e : tiles ) {
-                g->m.add_item_or_charges( e, item( shr.drop, calendar::turn, item::solitary_tag{} ) );
-            }
+    // Extract only passable tiles affected by shrapnel
+    std::vector<tripoint> tiles;
+    for( const auto &e : locations ) {
+        if( g->m.passable( e ) ) {
+            tiles.push_back( e );
         }
     }
+    const itype *fragment_drop = item_controller->find_template( shr.drop );
+    int qty = shr.casing_mass * std::min( 1.0, shr.recovery / 100.0 ) /
+              to_gram( fragment_drop->weight );
+    // Truncate to a random selection
+    std::shuffle( tiles.begin(), tiles.end(), rng_get_engine() );
+    tiles.resize( std::min( static_cast<int>( tiles.size() ), qty ) );
+
+    for( const auto &e : tiles ) {
+        g->m.add_item_or_charges( e, item( shr.drop, calendar::turn, item::solitary_tag{} ) );
+    }
 }
 
 int ballistic_damage( float velocity, float mass )
@@ -354,10 +386,11 @@ bool operator<( const fragment_cloud &us, const fragment_cloud &them )
 }
 
 // Global to smuggle data into shrapnel_calc() function without replicating it across entire map.
+// Thread local, fragment clouds of several explosions are cast at the same time.
 // Mass in kg
-float fragment_mass = 0.0001;
+static thread_local float fragment_mass = 0.0001;
 // Cross-sectional area in cm^2
-float fragment_area = 0.00001;
+static thread_local float fragment_area = 0.00001;
 
 // Projectile velocity in air. See https://fas.org/man/dod-101/navy/docs/es310/warheads/Warheads.htm
 // for a writeup of this exact calculation.
@@ -421,33 +454,52 @@ static float mass_to_area( const float mass )
     return fragment_radius * fragment_radius * M_PI;
 }
 
-std::vector<tripoint> game::shrapnel( const tripoint &src, int power,
-                                      int casing_mass, float per_fragment_mass, int range )
+namespace
 {
-    // The gurney equation wants the total mass of the casing.
-    const float fragment_velocity = gurney_spherical( power, casing_mass );
-    fragment_mass = per_fragment_mass;
-    fragment_area = mass_to_area( fragment_mass );
-    int fragment_count = casing_mass / fragment_mass;
 
-    // Contains all tiles reached by fragments.
-    std::vector<tripoint> distrib;
+struct fragment_grid {
+    fragment_cloud cells[MAPSIZE_X][MAPSIZE_Y];
+};
 
-    projectile proj;
-    proj.speed = fragment_velocity;
-    proj.range = range;
-    proj.proj_effects.insert( "NULL_SOURCE" );
+/** Fragments of one explosion, cast against the obstacles of its z-level. */
+struct shrapnel_job {
+    tripoint src;
+    int power;
+    int casing_mass;
+    float fragment_mass;
+    int range;
+    const fragment_grid *obstacles;
+    std::unique_ptr<fragment_grid> clouds;
+};
+
+} // namespace
+
+static std::unique_ptr<fragment_grid> build_fragment_obstacles( const int z )
+{
+    std::unique_ptr<fragment_grid> result( new fragment_grid() );
+    const tripoint start = { 0, 0, z };
+    const tripoint end = { g->m.getmapsize() *SEEX, g->m.getmapsize() *SEEY, z };
+    g->m.build_obstacle_cache( start, end, result->cells );
+    return result;
+}
+
+// Only reads the obstacle cache, so several of these can run at once.
+static void cast_fragments( shrapnel_job &job )
+{
+    // The gurney equation wants the total mass of the casing.
+    const float fragment_velocity = gurney_spherical( job.power, job.casing_mass );
+    fragment_mass = job.fragment_mass;
+    fragment_area = mass_to_area( fragment_mass );
+    int fragment_count = job.casing_mass / fragment_mass;
 
-    fragment_cloud obstacle_cache[ MAPSIZE_X ][ MAPSIZE_Y ];
-    fragment_cloud visited_cache[ MAPSIZE_X ][ MAPSIZE_Y ];
+    const auto &obstacle_cache = job.obstacles->cells;
+    job.clouds.reset( new fragment_grid() );
+    auto &visited_cache = job.clouds->cells;
+    const tripoint &src = job.src;
 
     // TODO: Calculate range based on max effective range for projectiles.
     // Basically bisect between 0 and map diameter using shrapnel_calc().
     // Need to update shadowcasting to support limiting range without adjusting initial distance.
-    const tripoint start = { 0, 0, src.z };
-    const tripoint end = { m.getmapsize() *SEEX, m.getmapsize() *SEEY, src.z };
-
-    m.build_obstacle_cache( start, end, obstacle_cache );
 
     // Shadowcasting normally ignores the origin square,
     // so apply it manually to catch monsters standing on the explosive.
@@ -459,19 +511,63 @@ std::vector<tripoint> game::shrapnel( const tripoint &src, int power,
     castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
                  update_fragment_cloud, accumulate_fragment_cloud>
                  ( visited_cache, obstacle_cache, src.x, src.y, 0, initial_cloud );
+}
+
+static void cast_all_fragments( std::vector<shrapnel_job> &jobs )
+{
+    const size_t workers = std::min<size_t>( jobs.size(),
+                           std::max( 1u, std::thread::hardware_concurrency() ) );
+    if( workers <= 1 ) {
+        for( auto &job : jobs ) {
+            cast_fragments( job );
+        }
+        return;
+    }
+    std::atomic<size_t> next_job( 0 );
+    const auto work = [&jobs, &next_job]() {
+        for( size_t i = next_job++; i < jobs.size(); i = next_job++ ) {
+            cast_fragments( jobs[i] );
+        }
+    };
+    std::vector<std::thread> threads;
+    for( size_t i = 1; i < workers; i++ ) {
+        threads.emplace_back( work );
+    }
+    work();
+    for( auto &t : threads ) {
+        t.join();
+    }
+}
+
+// Deals the damage of fragments that were already cast, returns all tiles that took damage.
+static std::vector<tripoint> apply_fragments( const shrapnel_job &job )
+{
+    map &m = g->m;
+    const tripoint &src = job.src;
+    const auto &visited_cache = job.clouds->cells;
+    const tripoint start = { 0, 0, src.z };
+    const tripoint end = { m.getmapsize() *SEEX, m.getmapsize() *SEEY, src.z };
+
+    // Contains all tiles reached by fragments.
+    std::vector<tripoint> distrib;
+
+    projectile proj;
+    proj.speed = gurney_spherical( job.power, job.casing_mass );
+    proj.range = job.range;
+    proj.proj_effects.insert( "NULL_SOURCE" );
 
     // Now visited_caches are populated with density and velocity of fragments.
     for( int x = start.x; x < end.x; x++ ) {
         for( int y = start.y; y < end.y; y++ ) {
-            fragment_cloud &cloud = visited_cache[x][y];
+            const fragment_cloud &cloud = visited_cache[x][y];
             if( cloud.density <= MIN_FRAGMENT_DENSITY ||
                 cloud.velocity <= MIN_EFFECTIVE_VELOCITY ) {
                 continue;
             }
             distrib.emplace_back( x, y, src.z );
             tripoint target( x, y, src.z );
-            int damage = ballistic_damage( cloud.velocity, fragment_mass );
-            auto critter = critter_at( target );
+            int damage = ballistic_damage( cloud.velocity, job.fragment_mass );
+            auto critter = g->critter_at( target );
             if( damage > 0 && critter && !critter->is_dead_state() ) {
                 std::poisson_distribution<> d( cloud.density );
                 int hits = d( rng_get_engine() );
@@ -550,6 +646,65 @@ std::vector<tripoint> game::shrapnel( const tripoint &src, int power,
     return distrib;
 }
 
+std::vector<tripoint> game::shrapnel( const tripoint &src, int power,
+                                      int casing_mass, float per_fragment_mass, int range )
+{
+    const std::unique_ptr<fragment_grid> obstacles = build_fragment_obstacles( src.z );
+    shrapnel_job job{ src, power, casing_mass, per_fragment_mass, range, obstacles.get(), nullptr };
+    cast_fragments( job );
+    return apply_fragments( job );
+}
+
+void game::process_explosions()
+{
+    // Explosions set off by these ones are queued up for the next round.
+    explosion_holds++;
+    while( !explosion_queue.empty() ) {
+        std::vector<queued_explosion> round;
+        round.swap( explosion_queue );
+
+        for( const auto &e : round ) {
+            const explosion_data &ex = e.ex;
+            explosion_noise( e.p, ex );
+            if( ex.distance_factor >= 1.0f ) {
+                debugmsg( "called game::explosion with factor >= 1.0 (infinite size)" );
+            } else if( ex.distance_factor > 0.0f && ex.power > 0.0f ) {
+                // Power rescaled to mean grams of TNT equivalent, this scales it roughly back to
+                // where it was before until we re-do blasting power to be based on TNT-equivalent
+                // directly.
+                do_blast( e.p, ex.power / 15.0, ex.distance_factor, ex.fire );
+            }
+        }
+
+        // All blasts of this round are done, so the obstacles are only built once per z-level.
+        std::map<int, std::unique_ptr<fragment_grid>> obstacles;
+        std::vector<shrapnel_job> jobs;
+        std::vector<const shrapnel_data *> casings;
+        for( const auto &e : round ) {
+            const shrapnel_data &shr = e.ex.shrapnel;
+            if( shr.casing_mass <= 0 ) {
+                continue;
+            }
+            std::unique_ptr<fragment_grid> &grid = obstacles[e.p.z];
+            if( !grid ) {
+                grid = build_fragment_obstacles( e.p.z );
+            }
+            jobs.push_back( shrapnel_job{ e.p, static_cast<int>( e.ex.power ), shr.casing_mass,
+                                          shr.fragment_mass, -1, grid.get(), nullptr } );
+            casings.push_back( &shr );
+        }
+        cast_all_fragments( jobs );
+
+        // Damage is dealt in the order the explosions were triggered.
+        for( size_t i = 0; i < jobs.size(); i++ ) {
+            drop_fragments( *casings[i], apply_fragments( jobs[i] ) );
+            // Free the clouds as we go, each one is a map sized array.
+            jobs[i].clouds.reset();
+        }
+    }
+    explosion_holds--;
+}
+
 float explosion_data::expected_range( float ratio ) const
 {
     if( power <= 0.0f || distance_factor >= 1.0f || distance_factor <= 0.0f ) {
@@ -30,6 +30,19 @@ struct explosion_data {
     int safe_range() const;
 };
 
+/**
+ * While an instance exists, game::explosion only queues explosions up. They all go off
+ * together when the last instance is destroyed, which lets their fragments be computed at once.
+ */
+class explosion_batch
+{
+    public:
+        explosion_batch();
+        ~explosion_batch();
+        explosion_batch( const explosion_batch & ) = delete;
+        explosion_batch &operator=( const explosion_batch & ) = delete;
+};
+
 shrapnel_data load_shrapnel_data( JsonObject &jo );
 explosion_data load_explosion_data( JsonObject &jo );
 
@@ -795,6 +795,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     if( !fieldlist[cur.getFieldType()].transparent[cur.getFieldDensity() - 1] ) {
                         dirty_transparency_cache = true;
                     }
+                    if( cur.getFieldType() == fd_fire ) {
+                        set_heat_cache_dirty( submap_z );
+                    }
                     current_submap->field_count--;
                     curfield.removeField( it++ );
                     continue;
@@ -892,6 +895,8 @@ bool map::process_fields_in_submap( submap *const current_submap,
 
                     // TODO: MATERIALS use fire resistance
                     case fd_fire: {
+                        // Burning fires change strength and spread, recompute the heat they radiate
+                        set_heat_cache_dirty( submap_z );
                         // Entire objects for ter/frn for flags
                         const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
                         bool sheltered = g->is_sheltered( p );
@@ -13,6 +13,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "action.h"
@@ -37,6 +38,7 @@
 #include "effect.h"
 #include "enums.h"
 #include "event.h"
+#include "explosion.h"
 #include "faction.h"
 #include "filesystem.h"
 #include "game_constants.h"
@@ -643,6 +645,8 @@ void game::setup()
     npc_kills.clear();
     // reset follower list
     follower_ids.clear();
+    overmap_npc_queue.clear();
+    overmap_npc_budget = 0;
     scent.reset();
 
     remoteveh_cache_time = calendar::before_time_starts;
@@ -1443,35 +1447,25 @@ bool game::do_turn()
     m.build_floor_caches();
 
     m.process_falling();
-    m.vehmove();
+    {
+        // Crashes, fires and fuses of this turn set off their explosions together.
+        explosion_batch explosions;
+        m.vehmove();
 
-    // Process power and fuel consumption for all vehicles, including off-map ones.
-    // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = sm_to_ms_copy( sm_loc.x, sm_loc.y );
-        point in_reality = m.getlocal( sm_topleft );
-
-        submap *sm = elem.second;
-
-        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
-        for( auto &veh : sm->vehicles ) {
-            veh->idle( in_bubble_z && m.inbounds( in_reality ) );
-        }
+        process_vehicle_power();
+        m.process_fields();
+        m.process_active_items();
     }
-    m.process_fields();
-    m.process_active_items();
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
     // Update vision caches for monsters. If this turns out to be expensive,
     // consider a stripped down cache just for monsters.
     m.build_map_cache( get_levz(), true );
+    // Apply sounds from previous turn to monster and NPC AI.
+    // Sounds are muffled by walls, so this needs the transparency cache built above.
+    sounds::process_sounds();
     monmove();
-    if( calendar::once_every( 3_minutes ) ) {
-        overmap_npc_move();
-    }
+    overmap_npc_move();
     update_stair_monsters();
     u.process_turn();
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
@@ -1533,6 +1527,45 @@ bool game::do_turn()
     return false;
 }
 
+void game::process_vehicle_power()
+{
+    // Process power and fuel consumption for all vehicles, including off-map ones.
+    // m.vehmove used to do this, but now it only give them moves instead.
+    const tripoint abs_sub = m.get_abs_sub();
+    for( const wrapped_vehicle &wv : m.get_vehicles() ) {
+        wv.v->idle( true );
+        if( wv.v->is_active_off_map() ) {
+            MAPBUFFER.add_active_vehicle_submap( tripoint( abs_sub.x + wv.i, abs_sub.y + wv.j,
+                                                 wv.z ) );
+        }
+    }
+
+    // Everything else in the buffer only needs processing if something on it is running.
+    // Copied, because submaps that went quiet are removed from the set.
+    const std::set<tripoint> active_submaps = MAPBUFFER.get_active_vehicle_submaps();
+    const int size = m.getmapsize();
+    for( const tripoint &sm_loc : active_submaps ) {
+        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
+        if( in_bubble_z && sm_loc.x >= abs_sub.x && sm_loc.x < abs_sub.x + size &&
+            sm_loc.y >= abs_sub.y && sm_loc.y < abs_sub.y + size ) {
+            continue;
+        }
+        submap *sm = MAPBUFFER.lookup_submap( sm_loc );
+        if( sm == nullptr ) {
+            MAPBUFFER.remove_active_vehicle_submap( sm_loc );
+            continue;
+        }
+        bool still_active = false;
+        for( auto &veh : sm->vehicles ) {
+            veh->idle( false );
+            still_active |= veh->is_active_off_map();
+        }
+        if( !still_active ) {
+            MAPBUFFER.remove_active_vehicle_submap( sm_loc );
+        }
+    }
+}
+
 void game::set_driving_view_offset( const point &p )
 {
     // remove the previous driving offset,
@@ -1709,44 +1742,11 @@ void game::update_weather()
 
 int get_heat_radiation( const tripoint &location, bool direct )
 {
-    // Direct heat from fire sources
-    // Cache fires to avoid scanning the map around us bp times
-    // Stored as intensity-distance pairs
-    int temp_mod = 0;
-    std::vector<std::pair<int, int>> fires;
-    fires.reserve( 13 * 13 );
-    int best_fire = 0;
-    for( const tripoint &dest : g->m.points_in_radius( location, 6 ) ) {
-        int heat_intensity = 0;
-
-        int ffire = g->m.get_field_strength( dest, fd_fire );
-        if( ffire > 0 ) {
-            heat_intensity = ffire;
-        } else if( g->m.tr_at( dest ).loadid == tr_lava ) {
-            heat_intensity = 3;
-        }
-        if( heat_intensity == 0 || !g->m.sees( location, dest, -1 ) ) {
-            // No heat source here
-            continue;
-        }
-        // Ensure fire_dist >= 1 to avoid divide-by-zero errors.
-        const int fire_dist = std::max( 1, square_dist( dest, location ) );
-        fires.emplace_back( std::make_pair( heat_intensity, fire_dist ) );
-        if( fire_dist <= 1 ) {
-            // Extend limbs/lean over a single adjacent fire to warm up
-            best_fire = std::max( best_fire, heat_intensity );
-        }
-    }
-
-    for( const auto &intensity_dist : fires ) {
-        const int intensity = intensity_dist.first;
-        const int distance = intensity_dist.second;
-        temp_mod += 6 * intensity * intensity / distance;
-    }
+    // Direct heat from fire sources, precomputed per z-level by the map's heat cache
     if( direct ) {
-        return best_fire;
+        return g->m.get_direct_heat( location );
     }
-    return temp_mod;
+    return g->m.get_radiant_heat( location );
 }
 
 int get_convection_temperature( const tripoint &location )
@@ -4689,20 +4689,37 @@ void game::monmove()
 
 void game::overmap_npc_move()
 {
-    std::vector<npc *> travelling_npcs;
+    static const time_duration round_length = 3_minutes;
+    if( calendar::once_every( round_length ) ) {
+        // Anything left over from the last round goes first, then the rest in follower order.
+        const std::set<int> queued( overmap_npc_queue.begin(), overmap_npc_queue.end() );
+        for( const int id : get_follower_list() ) {
+            if( queued.count( id ) == 0 ) {
+                overmap_npc_queue.push_back( id );
+            }
+        }
+        const int turns = to_turns<int>( round_length );
+        overmap_npc_budget = ( static_cast<int>( overmap_npc_queue.size() ) + turns - 1 ) / turns;
+    }
+    if( overmap_npc_queue.empty() ) {
+        return;
+    }
+
+    int moved = 0;
+    bool travelled = false;
     // for now just processing NPC followers on travelling missions
-    for( auto &elem : get_follower_list() ) {
-        std::shared_ptr<npc> npc_to_get = overmap_buffer.find_npc( elem );
+    while( moved < overmap_npc_budget && !overmap_npc_queue.empty() ) {
+        std::shared_ptr<npc> npc_to_get = overmap_buffer.find_npc( overmap_npc_queue.front() );
+        overmap_npc_queue.pop_front();
         if( !npc_to_get ) {
             continue;
         }
-        npc *npc_to_add = npc_to_get.get();
-        if( ( !npc_to_add->is_active() || rl_dist( u.pos(), npc_to_add->pos() ) > SEEX * 2 ) &&
-            npc_to_add->mission == NPC_MISSION_TRAVELLING ) {
-            travelling_npcs.push_back( npc_to_add );
+        npc *elem = npc_to_get.get();
+        if( ( elem->is_active() && rl_dist( u.pos(), elem->pos() ) <= SEEX * 2 ) ||
+            elem->mission != NPC_MISSION_TRAVELLING ) {
+            continue;
         }
-    }
-    for( auto &elem : travelling_npcs ) {
+        moved++;
         if( elem->has_omt_destination() ) {
             tripoint sm_tri;
             tripoint next_point;
@@ -4720,10 +4737,19 @@ void game::overmap_npc_move()
                          elem->disp_name() );
             }
             elem->travel_overmap( sm_tri );
-            reload_npcs();
+            travelled = true;
         }
     }
-    return;
+    if( travelled ) {
+        reload_npcs();
+    }
+    if( moved == 0 ) {
+        return;
+    }
+    const npc_path_cache_stats paths = overmap_buffer.take_npc_path_stats();
+    add_msg( m_debug, "overmap_npc_move: %d npcs moved, %d waiting, %d of %d paths from cache",
+             moved, static_cast<int>( overmap_npc_queue.size() ), paths.hits,
+             paths.hits + paths.misses );
 }
 
 void game::flashbang( const tripoint &p, bool player_immune )
@@ -7429,9 +7455,12 @@ look_around_result game::look_around( catacurses::window w_info, tripoint &cente
 
 std::vector<map_item_stack> game::find_nearby_items( int iRadius )
 {
-    std::map<std::string, map_item_stack> temp_items;
     std::vector<map_item_stack> ret;
-    std::vector<std::string> item_order;
+    // Items are listed by name, in the order the names are first seen
+    std::unordered_map<std::string, size_t> stack_by_name;
+    // Stacks of each item type, items that would stack with one of them share its name, so
+    // most items are placed without building their name at all.
+    std::unordered_map<const itype *, std::vector<size_t>> stacks_by_type;
 
     if( u.is_blind() ) {
         return ret;
@@ -7444,24 +7473,35 @@ std::vector<map_item_stack> game::find_nearby_items( int iRadius )
             u.sees( points_p_it ) &&
             m.sees_some_items( points_p_it, u ) ) {
 
+            const tripoint relative_pos = points_p_it - u.pos();
             for( auto &elem : m.i_at( points_p_it ) ) {
-                const std::string name = elem.tname();
-                const tripoint relative_pos = points_p_it - u.pos();
+                std::vector<size_t> &same_type = stacks_by_type[elem.type];
+                // Freshness shows up in the name of food in steps that don't match stacking
+                if( !elem.goes_bad() ) {
+                    const auto stack = std::find_if( same_type.begin(), same_type.end(),
+                    [&ret, &elem]( const size_t i ) {
+                        return elem.stacks_with( *ret[i].example );
+                    } );
+                    if( stack != same_type.end() ) {
+                        ret[*stack].add_at_pos( &elem, relative_pos );
+                        continue;
+                    }
+                }
 
-                if( std::find( item_order.begin(), item_order.end(), name ) == item_order.end() ) {
-                    item_order.push_back( name );
-                    temp_items[name] = map_item_stack( &elem, relative_pos );
+                const auto found = stack_by_name.emplace( elem.tname(), ret.size() );
+                if( found.second ) {
+                    ret.emplace_back( &elem, relative_pos );
                 } else {
-                    temp_items[name].add_at_pos( &elem, relative_pos );
+                    ret[found.first->second].add_at_pos( &elem, relative_pos );
+                }
+                if( std::find( same_type.begin(), same_type.end(),
+                               found.first->second ) == same_type.end() ) {
+                    same_type.push_back( found.first->second );
                 }
             }
         }
     }
 
-    for( auto &elem : item_order ) {
-        ret.push_back( temp_items[elem] );
-    }
-
     return ret;
 }
 
@@ -8409,7 +8449,7 @@ bool game::consume_liquid( item &liquid, const int radius )
     return original_charges != liquid.charges;
 }
 
-bool game::handle_liquid_from_ground( std::list<item>::iterator on_ground, const tripoint &pos,
+bool game::handle_liquid_from_ground( item_stack::iterator on_ground, const tripoint &pos,
                                       const int radius )
 {
     // TODO: not all code paths on handle_liquid consume move points, fix that.
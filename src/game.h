@@ -3,6 +3,7 @@
 #define GAME_H
 
 #include <array>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
@@ -15,6 +16,7 @@
 #include "game_constants.h"
 #include "int_id.h"
 #include "item_location.h"
+#include "item_stack.h"
 #include "optional.h"
 #include "pimpl.h"
 #include "posix_time.h"
@@ -226,6 +228,11 @@ class game
 
         /** write statistics to stdout and @return true if successful */
         bool dump_stats( const std::string &what, dump_mode mode, const std::vector<std::string> &opts );
+        /**
+         * Generate and save the overmaps within @p radius overmaps of the start and, if
+         * @p city_maps is set, the maps of their cities. @return true if successful.
+         */
+        bool pregenerate_world( const std::string &world, int radius, bool city_maps );
 
         /** Returns false if saving failed. */
         bool save();
@@ -236,6 +243,11 @@ class game
         void start_calendar();
         /** MAIN GAME LOOP. Returns true if game is over (death, saved, quit, etc.). */
         bool do_turn();
+        /**
+         * Per-turn power and fuel consumption of vehicles: everything in the reality bubble
+         * and the running vehicles elsewhere in the @ref mapbuffer.
+         */
+        void process_vehicle_power();
         void draw();
         void draw_ter( bool draw_sounds = true );
         void draw_ter( const tripoint &center, bool looking = false, bool draw_sounds = true );
@@ -272,6 +284,12 @@ class game
         void explosion(
             const tripoint &p, const explosion_data &ex
         );
+        /**
+         * Sets off all queued explosions, see @ref explosion_batch. Blasts go off one after
+         * another, then the fragments of the whole batch are cast in parallel and their damage is
+         * dealt in the order the explosions were triggered. Chain reactions form the next batch.
+         */
+        void process_explosions();
 
         /** Helper for explosion, does the actual blast. */
         void do_blast( const tripoint &p, float power, float factor, bool fire );
@@ -757,7 +775,7 @@ class game
          * The iterator is invalidated in that case. Otherwise the item remains but may have
          * fewer charges.
          */
-        bool handle_liquid_from_ground( std::list<item>::iterator on_ground, const tripoint &pos,
+        bool handle_liquid_from_ground( item_stack::iterator on_ground, const tripoint &pos,
                                         int radius = 0 );
 
         /**
@@ -932,7 +950,6 @@ class game
         };
 
         game::vmenu_ret list_items( const std::vector<map_item_stack> &item_list );
-        std::vector<map_item_stack> find_nearby_items( int iRadius );
         void reset_item_list_state( const catacurses::window &window, int height, bool bRadiusSort );
         std::string sFilter; // this is a member so that it's remembered over time
         std::string list_item_upvote;
@@ -994,6 +1011,8 @@ class game
         void set_critter_died();
         void mon_info( const catacurses::window &,
                        int hor_padding = 0 ); // Prints a list of nearby monsters
+        /** Items the player sees within iRadius, grouped by name, closest first. */
+        std::vector<map_item_stack> find_nearby_items( int iRadius );
     private:
         void wield();
         void wield( int pos ); // Wield a weapon  'w'
@@ -1050,7 +1069,11 @@ class game
         // Routine loop functions, approximately in order of execution
         void cleanup_dead();     // Delete any dead NPCs/monsters
         void monmove();          // Monster movement
-        void overmap_npc_move(); // NPC overmap movement
+        /**
+         * NPC overmap movement. Every travelling follower moves one overmap tile per round of
+         * three minutes, the moves are spread evenly over the turns of the round.
+         */
+        void overmap_npc_move();
         void process_activity(); // Processes and enacts the player's activity
         void update_weather();   // Updates the temperature and weather patten
         void handle_key_blocking_activity(); // Abort reading etc.
@@ -1114,6 +1137,10 @@ class game
         time_point nextweather; // The time on which weather will shift next.
         int next_npc_id, next_mission_id; // Keep track of UIDs
         std::vector<int> follower_ids; // Keep track of follower NPC IDs
+        /** Followers still to be moved on the overmap this round, see overmap_npc_move. */
+        std::deque<int> overmap_npc_queue;
+        /** How many travelling followers are moved per turn this round. */
+        int overmap_npc_budget = 0;
         std::map<mtype_id, int> kills;         // Player's kill count
         std::list<std::string> npc_kills;      // names of NPCs the player killed
         int moves_since_last_save;
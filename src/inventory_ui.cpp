@@ -972,8 +972,9 @@ void selection_column::on_change( const inventory_entry &entry )
 }
 
 // TODO: Move it into some 'item_stack' class.
-std::vector<std::list<item *>> restack_items( const std::list<item>::const_iterator &from,
-                            const std::list<item>::const_iterator &to, bool check_components = false )
+template<typename Iter>
+std::vector<std::list<item *>> restack_items( const Iter &from, const Iter &to,
+                            bool check_components = false )
 {
     std::vector<std::list<item *>> res;
 
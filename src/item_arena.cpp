@@ -0,0 +1,61 @@
+#include "item_arena.h"
+
+// Number of nodes in the first chunk, later chunks double in size up to the maximum.
+static constexpr size_t min_chunk_nodes = 16;
+static constexpr size_t max_chunk_nodes = 256;
+
+static size_t round_to_alignment( const size_t bytes )
+{
+    constexpr size_t align = alignof( std::max_align_t );
+    return ( bytes + align - 1 ) / align * align;
+}
+
+void *item_arena::allocate( const size_t bytes )
+{
+    const size_t rounded = round_to_alignment( bytes );
+    if( node_size == 0 ) {
+        node_size = rounded;
+    } else if( rounded != node_size ) {
+        return ::operator new( bytes );
+    }
+
+    live++;
+    if( free_list != nullptr ) {
+        free_node *const n = free_list;
+        free_list = n->next;
+        return n;
+    }
+    if( unused == 0 ) {
+        const size_t nodes = chunks.size() < 5 ? min_chunk_nodes << chunks.size() : max_chunk_nodes;
+        chunks.emplace_back( new char[nodes * node_size] );
+        next_unused = chunks.back().get();
+        unused = nodes;
+    }
+    void *const result = next_unused;
+    next_unused += node_size;
+    unused--;
+    return result;
+}
+
+void item_arena::deallocate( void *const p, const size_t bytes )
+{
+    if( round_to_alignment( bytes ) != node_size ) {
+        ::operator delete( p );
+        return;
+    }
+
+    free_node *const n = static_cast<free_node *>( p );
+    n->next = free_list;
+    free_list = n;
+    if( --live == 0 ) {
+        release();
+    }
+}
+
+void item_arena::release()
+{
+    chunks.clear();
+    free_list = nullptr;
+    next_unused = nullptr;
+    unused = 0;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef ITEM_ARENA_H
+#define ITEM_ARENA_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <new>
+#include <vector>
+
+class item;
+
+/**
+ * Node pool for the item lists of one submap.
+ *
+ * Items on the map are stored in linked lists so that iterators and references to them stay
+ * valid while other items on the same tile come and go. With the default allocator every
+ * node is a separate heap allocation and the items of a tile end up scattered all over
+ * memory. The arena hands out nodes from large chunks owned by the submap instead, so the
+ * items of a tile (which are usually created together by mapgen or by loading the submap)
+ * sit next to each other and walking a pile or a whole submap stays in cache.
+ *
+ * Only allocations of a single node size are pooled, anything else goes to the heap.
+ * Freed nodes are reused, the chunks are released once the arena is empty.
+ */
+class item_arena
+{
+    public:
+        item_arena() = default;
+        item_arena( const item_arena & ) = delete;
+        item_arena &operator=( const item_arena & ) = delete;
+
+        void *allocate( size_t bytes );
+        void deallocate( void *p, size_t bytes );
+
+        /** Number of nodes currently handed out. */
+        size_t size() const {
+            return live;
+        }
+
+    private:
+        struct free_node {
+            free_node *next;
+        };
+
+        void release();
+
+        std::vector<std::unique_ptr<char[]>> chunks;
+        free_node *free_list = nullptr;
+        // Next unused node in the newest chunk and how many are left there
+        char *next_unused = nullptr;
+        size_t unused = 0;
+        size_t node_size = 0;
+        size_t live = 0;
+};
+
+/**
+ * Allocator that draws from an @ref item_arena, or from the heap if there is none.
+ *
+ * Containers only take the arena along when they are constructed with the allocator or moved
+ * from, a copy of a list always uses the heap. This way a copy never outlives the submap
+ * whose arena it would otherwise use. Two lists can only exchange nodes (splice, swap)
+ * when they compare equal, i.e. share the same arena.
+ */
+template<typename T>
+class arena_allocator
+{
+    public:
+        using value_type = T;
+
+        arena_allocator() noexcept = default;
+        explicit arena_allocator( item_arena *arena ) noexcept : arena( arena ) { }
+        template<typename U>
+        arena_allocator( const arena_allocator<U> &other ) noexcept : arena( other.arena ) { }
+
+        T *allocate( size_t n ) {
+            if( arena == nullptr ) {
+                return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+            }
+            return static_cast<T *>( arena->allocate( n * sizeof( T ) ) );
+        }
+        void deallocate( T *p, size_t n ) noexcept {
+            if( arena == nullptr ) {
+                ::operator delete( p );
+            } else {
+                arena->deallocate( p, n * sizeof( T ) );
+            }
+        }
+
+        arena_allocator select_on_container_copy_construction() const {
+            return arena_allocator();
+        }
+
+        item_arena *arena = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==( const arena_allocator<T> &lhs, const arena_allocator<U> &rhs )
+{
+    return lhs.arena == rhs.arena;
+}
+
+template<typename T, typename U>
+bool operator!=( const arena_allocator<T> &lhs, const arena_allocator<U> &rhs )
+{
+    return lhs.arena != rhs.arena;
+}
+
+/** The items on a map tile or in a vehicle part. */
+using item_list = std::list<item, arena_allocator<item>>;
+
+#endif
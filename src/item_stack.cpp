@@ -1,7 +1,6 @@
 #include "item_stack.h"
 
 #include <algorithm>
-#include <list>
 
 #include "item.h"
 #include "units.h"
@@ -24,42 +23,42 @@ void item_stack::clear()
     }
 }
 
-std::list<item>::iterator item_stack::begin()
+item_stack::iterator item_stack::begin()
 {
     return mystack->begin();
 }
 
-std::list<item>::iterator item_stack::end()
+item_stack::iterator item_stack::end()
 {
     return mystack->end();
 }
 
-std::list<item>::const_iterator item_stack::begin() const
+item_stack::const_iterator item_stack::begin() const
 {
     return mystack->cbegin();
 }
 
-std::list<item>::const_iterator item_stack::end() const
+item_stack::const_iterator item_stack::end() const
 {
     return mystack->cend();
 }
 
-std::list<item>::reverse_iterator item_stack::rbegin()
+item_stack::reverse_iterator item_stack::rbegin()
 {
     return mystack->rbegin();
 }
 
-std::list<item>::reverse_iterator item_stack::rend()
+item_stack::reverse_iterator item_stack::rend()
 {
     return mystack->rend();
 }
 
-std::list<item>::const_reverse_iterator item_stack::rbegin() const
+item_stack::const_reverse_iterator item_stack::rbegin() const
 {
     return mystack->crbegin();
 }
 
-std::list<item>::const_reverse_iterator item_stack::rend() const
+item_stack::const_reverse_iterator item_stack::rend() const
 {
     return mystack->crend();
 }
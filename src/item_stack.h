@@ -3,8 +3,7 @@
 #define ITEM_STACK_H
 
 #include <cstddef>
-#include <list>
-
+#include "item_arena.h"
 #include "units.h"
 
 class item;
@@ -20,28 +19,33 @@ class item;
 class item_stack
 {
     protected:
-        std::list<item> *mystack;
+        item_list *mystack;
 
     public:
-        item_stack( std::list<item> *mystack ) : mystack( mystack ) { }
+        using iterator = item_list::iterator;
+        using const_iterator = item_list::const_iterator;
+        using reverse_iterator = item_list::reverse_iterator;
+        using const_reverse_iterator = item_list::const_reverse_iterator;
+
+        item_stack( item_list *mystack ) : mystack( mystack ) { }
 
         size_t size() const;
         bool empty() const;
-        virtual std::list<item>::iterator erase( std::list<item>::iterator it ) = 0;
+        virtual iterator erase( iterator it ) = 0;
         virtual void push_back( const item &newitem ) = 0;
-        virtual void insert_at( std::list<item>::iterator, const item &newitem ) = 0;
+        virtual void insert_at( iterator, const item &newitem ) = 0;
         virtual void clear();
         item &front();
         item &operator[]( size_t index );
 
-        std::list<item>::iterator begin();
-        std::list<item>::iterator end();
-        std::list<item>::const_iterator begin() const;
-        std::list<item>::const_iterator end() const;
-        std::list<item>::reverse_iterator rbegin();
-        std::list<item>::reverse_iterator rend();
-        std::list<item>::const_reverse_iterator rbegin() const;
-        std::list<item>::const_reverse_iterator rend() const;
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
 
         /** Maximum number of items allowed here */
         virtual int count_limit() const = 0;
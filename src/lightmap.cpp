@@ -1,6 +1,7 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -13,6 +14,7 @@
 #include "mtype.h"
 #include "npc.h"
 #include "submap.h"
+#include "trap.h"
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vpart_position.h"
@@ -45,8 +47,8 @@ std::string four_quadrants::to_string() const
                           ( *this )[quadrant::SW], ( *this )[quadrant::NW] );
 }
 
-void map::add_light_from_items( const tripoint &p, std::list<item>::iterator begin,
-                                std::list<item>::iterator end )
+void map::add_light_from_items( const tripoint &p, item_stack::iterator begin,
+                                item_stack::iterator end )
 {
     for( auto itm_it = begin; itm_it != end; ++itm_it ) {
         float ilum = 0.0; // brightness
@@ -150,6 +152,7 @@ void map::build_transparency_cache( const int zlev )
         }
     }
     map_cache.transparency_cache_dirty = false;
+    map_cache.heat_cache_dirty = true;
 }
 
 void map::apply_character_light( player &p )
@@ -1177,6 +1180,134 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
     }
 }
 
+// Heat only cares about whether the source is in line of sight, not how faint it looks.
+static float heat_calc( const float &numerator, const float &, const int & )
+{
+    return numerator;
+}
+
+/**
+ * Accumulates the heat radiated by every fire and lava tile on the z-level into
+ * radiant_heat_cache and direct_heat_cache, so that temperature queries don't have
+ * to scan for heat sources and check line of sight themselves.
+ *
+ * Line of sight is symmetric, so instead of looking for sources from every tile that
+ * wants to know its temperature, each source casts once and deposits heat on the tiles
+ * it can see.
+ */
+void map::build_heat_cache( const int zlev )
+{
+    auto &map_cache = get_cache( zlev );
+    if( !map_cache.heat_cache_dirty ) {
+        return;
+    }
+    map_cache.heat_cache_dirty = false;
+
+    auto &radiant_heat_cache = map_cache.radiant_heat_cache;
+    auto &direct_heat_cache = map_cache.direct_heat_cache;
+    auto &seen = map_cache.heat_source_buffer;
+    const auto &transparency_cache = map_cache.transparency_cache;
+
+    constexpr int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
+    std::uninitialized_fill_n( &radiant_heat_cache[0][0], map_dimensions, 0 );
+    std::uninitialized_fill_n( &direct_heat_cache[0][0], map_dimensions, 0 );
+
+    auto &fire_cache = map_cache.fire_cache;
+    fire_cache.clear();
+
+    // Heat sources as position-intensity pairs
+    std::vector<std::pair<point, int>> sources;
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const auto cur_submap = get_submap_at_grid( {smx, smy, zlev} );
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                for( int sy = 0; sy < SEEY; ++sy ) {
+                    int heat_intensity = 0;
+                    if( cur_submap->field_count > 0 ) {
+                        const field_entry *fire = cur_submap->fld[sx][sy].findField( fd_fire );
+                        if( fire != nullptr ) {
+                            heat_intensity = fire->getFieldDensity();
+                            fire_cache.emplace_back( sx + smx * SEEX, sy + smy * SEEY );
+                        }
+                    }
+                    if( heat_intensity == 0 ) {
+                        const point l( sx, sy );
+                        const trap_id &ter_trap = cur_submap->get_ter( l ).obj().trap;
+                        const trap_id tid = ter_trap != tr_null ? ter_trap :
+                                            cur_submap->get_trap( l );
+                        if( tid == tr_lava ) {
+                            heat_intensity = 3;
+                        }
+                    }
+                    if( heat_intensity > 0 ) {
+                        sources.emplace_back( point( sx + smx * SEEX, sy + smy * SEEY ),
+                                              heat_intensity );
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort( fire_cache.begin(), fire_cache.end() );
+
+    // castLight stops after 60 - offsetDistance rows, so use the offset to bound the cast.
+    constexpr int heat_radius = 6;
+    constexpr int offset_distance = 60 - heat_radius;
+    for( const auto &source : sources ) {
+        const point &p = source.first;
+        const int intensity = source.second;
+        const int min_x = std::max( 0, p.x - heat_radius );
+        const int max_x = std::min( MAPSIZE_X - 1, p.x + heat_radius );
+        const int min_y = std::max( 0, p.y - heat_radius );
+        const int max_y = std::min( MAPSIZE_Y - 1, p.y + heat_radius );
+        for( int x = min_x; x <= max_x; x++ ) {
+            std::fill( &seen[x][min_y], &seen[x][max_y] + 1, 0.0f );
+        }
+        seen[p.x][p.y] = LIGHT_TRANSPARENCY_CLEAR;
+        castLightAll<float, float, heat_calc, sight_check, update_light, accumulate_transparency>(
+            seen, transparency_cache, p.x, p.y, offset_distance, LIGHT_TRANSPARENCY_CLEAR );
+
+        for( int x = min_x; x <= max_x; x++ ) {
+            for( int y = min_y; y <= max_y; y++ ) {
+                if( seen[x][y] <= 0.0f ) {
+                    continue;
+                }
+                // Ensure fire_dist >= 1 to avoid divide-by-zero errors.
+                const int fire_dist = std::max( 1, square_dist( p.x, p.y, x, y ) );
+                radiant_heat_cache[x][y] += 6 * intensity * intensity / fire_dist;
+                if( fire_dist <= 1 ) {
+                    // Extend limbs/lean over a single adjacent fire to warm up
+                    direct_heat_cache[x][y] = std::max( direct_heat_cache[x][y], intensity );
+                }
+            }
+        }
+    }
+}
+
+int map::get_radiant_heat( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        return 0;
+    }
+    build_heat_cache( p.z );
+    return get_cache( p.z ).radiant_heat_cache[p.x][p.y];
+}
+
+int map::get_direct_heat( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        return 0;
+    }
+    build_heat_cache( p.z );
+    return get_cache( p.z ).direct_heat_cache[p.x][p.y];
+}
+
+const std::vector<point> &map::get_fire_positions( const int zlev )
+{
+    build_heat_cache( zlev );
+    return get_cache( zlev ).fire_cache;
+}
+
 //Schraudolph's algorithm with John's constants
 static inline
 float fastexp( float x )
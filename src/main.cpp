@@ -1,6 +1,8 @@
 /* Entry point and main loop for Cataclysm
  */
 
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <iostream>
@@ -134,6 +136,9 @@ int main( int argc, char *argv[] )
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string pregenerate; /** if set generate this world and exit */
+    int pregenerate_radius = 1;
+    bool pregenerate_cities = false;
 
 #if defined(__ANDROID__)
     // Start the standard output logging redirector
@@ -174,7 +179,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 12> first_pass_arguments = {{
+        const std::array<arg_handler, 13> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -242,6 +247,32 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--pregenerate", "<world> [radius = 1] [cities]",
+                    "Generates the overmaps around the start of a world, and the maps of "
+                    "their cities if asked to",
+                    section_default,
+                    [&]( int n, const char *params[] ) -> int {
+                        if( n < 1 )
+                        {
+                            return -1;
+                        }
+                        test_mode = true;
+                        pregenerate = params[0];
+                        int consumed = 1;
+                        if( n > consumed && isdigit( params[consumed][0] ) )
+                        {
+                            pregenerate_radius = atoi( params[consumed] );
+                            consumed++;
+                        }
+                        if( n > consumed && !strcmp( params[consumed], "cities" ) )
+                        {
+                            pregenerate_cities = true;
+                            consumed++;
+                        }
+                        return consumed;
+                    }
+                },
                 {
                     "--world", "<name>",
                     "Load world",
@@ -619,6 +650,11 @@ int main( int argc, char *argv[] )
             init_colors();
             exit( g->dump_stats( dump, dmode, opts ) ? 0 : 1 );
         }
+        if( !pregenerate.empty() ) {
+            init_colors();
+            exit( g->pregenerate_world( pregenerate, pregenerate_radius,
+                                        pregenerate_cities ) && !test_dirty ? 0 : 1 );
+        }
         if( check_mods ) {
             init_colors();
             loading_ui ui( false );
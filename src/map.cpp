@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -70,13 +71,13 @@ extern bool is_valid_in_w_terrain( int, int );
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
-static std::list<item>  nulitems;          // Returned when &i_at() is asked for an OOB value
+static item_list        nulitems;          // Returned when &i_at() is asked for an OOB value
 static field            nulfield;          // Returned when &field_at() is asked for an OOB value
 static int              null_temperature;  // Because radiation does it too
 static level_cache      nullcache;         // Dummy cache for z-levels outside bounds
 
 // Map stack methods.
-std::list<item>::iterator map_stack::erase( std::list<item>::iterator it )
+map_stack::iterator map_stack::erase( iterator it )
 {
     return myorigin->i_rem( location, it );
 }
@@ -86,7 +87,7 @@ void map_stack::push_back( const item &newitem )
     myorigin->add_item_or_charges( location, newitem );
 }
 
-void map_stack::insert_at( std::list<item>::iterator index,
+void map_stack::insert_at( iterator index,
                            const item &newitem )
 {
     myorigin->add_item_at( location, index, newitem );
@@ -197,6 +198,10 @@ void map::add_vehicle_to_cache( vehicle *veh )
 
     auto &ch = get_cache( veh->smz );
     ch.veh_in_active_range = true;
+    // Keep the area of parts that are already cached, they are only removed along with it
+    const auto old_area = ch.veh_cached_areas.find( veh );
+    bool has_area = old_area != ch.veh_cached_areas.end();
+    rectangle area = has_area ? old_area->second : rectangle();
     // Get parts
     std::vector<vehicle_part> &parts = veh->parts;
     int partid = 0;
@@ -211,6 +216,16 @@ void map::add_vehicle_to_cache( vehicle *veh )
         if( inbounds( p ) ) {
             ch.veh_exists_at[p.x][p.y] = true;
         }
+        if( !has_area ) {
+            area = rectangle( point( p.x, p.y ), point( p.x, p.y ) );
+            has_area = true;
+        } else {
+            area.p_min = point( std::min( area.p_min.x, p.x ), std::min( area.p_min.y, p.y ) );
+            area.p_max = point( std::max( area.p_max.x, p.x ), std::max( area.p_max.y, p.y ) );
+        }
+    }
+    if( has_area ) {
+        ch.veh_cached_areas[veh] = area;
     }
 }
 
@@ -223,9 +238,18 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 
     // Existing must be cleared
     auto &ch = get_cache( old_zlevel );
-    auto it = ch.veh_cached_parts.begin();
+    const auto area = ch.veh_cached_areas.find( veh );
+    if( area == ch.veh_cached_areas.end() ) {
+        // Nothing of it is cached
+        add_vehicle_to_cache( veh );
+        return;
+    }
+    // The cache is ordered by x first, only the columns covered by the vehicle need a look
+    const rectangle old_area = area->second;
+    ch.veh_cached_areas.erase( area );
+    auto it = ch.veh_cached_parts.lower_bound( tripoint( old_area.p_min, INT_MIN ) );
     const auto end = ch.veh_cached_parts.end();
-    while( it != end ) {
+    while( it != end && it->first.x <= old_area.p_max.x ) {
         if( it->second.first == veh ) {
             const tripoint p = it->first;
             if( inbounds( p ) ) {
@@ -253,6 +277,22 @@ void map::clear_vehicle_cache( const int zlev )
         }
         ch.veh_cached_parts.erase( part );
     }
+    ch.veh_cached_areas.clear();
+}
+
+std::vector<rectangle> map::get_vehicle_areas( const rectangle &area, const int zlev,
+        const vehicle *ignore ) const
+{
+    std::vector<rectangle> result;
+    for( const auto &elem : get_cache_ref( zlev ).veh_cached_areas ) {
+        const rectangle &r = elem.second;
+        if( elem.first != ignore &&
+            r.p_min.x <= area.p_max.x && area.p_min.x <= r.p_max.x &&
+            r.p_min.y <= area.p_max.y && area.p_min.y <= r.p_max.y ) {
+            result.push_back( r );
+        }
+    }
+    return result;
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -1036,6 +1076,8 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
     veh->posx = dst_offset.x;
     veh->posy = dst_offset.y;
     veh->smz = p2.z;
+    // Cables of other vehicles may have led to the old position
+    vehicle::invalidate_power_grids();
     // Invalidate vehicle's point cache
     veh->occupied_cache_time = calendar::before_time_starts;
     if( src_submap != dst_submap ) {
@@ -1160,6 +1202,97 @@ void map::set( const tripoint &p, const ter_id &new_terrain, const furn_id &new_
     ter_set( p, new_terrain );
 }
 
+void map::set_row( const tripoint &p, const int length, const ter_id &new_terrain,
+                   const furn_id &new_furniture )
+{
+    const bool set_ter = new_terrain != t_null;
+    const bool set_furn = new_furniture != f_null;
+    const ter_t &new_t = new_terrain.obj();
+    const furn_t &new_f = new_furniture.obj();
+    const bool grabbing = g->u.get_grab_type() == OBJECT_FURNITURE;
+    bool changed = false;
+    bool transparency_changed = false;
+    bool outside_changed = false;
+    bool floor_changed = false;
+    bool heat_changed = false;
+
+    tripoint q = p;
+    const int end_x = p.x + length;
+    while( q.x < end_x ) {
+        if( !inbounds( q ) ) {
+            q.x++;
+            continue;
+        }
+        point l;
+        submap *const current_submap = get_submap_at( q, l );
+        const int end_in_submap = std::min( end_x, q.x + SEEX - l.x );
+        for( ; q.x < end_in_submap; q.x++, l.x++ ) {
+            const tripoint above( q.x, q.y, q.z + 1 );
+            if( set_furn && current_submap->get_furn( l ) != new_furniture ) {
+                const furn_t &old_f = current_submap->get_furn( l ).obj();
+                current_submap->set_furn( l, new_furniture );
+                if( grabbing && g->u.grab_point == q && new_f.move_str_req < 0 ) {
+                    add_msg( _( "The %s you were grabbing is destroyed!" ), old_f.name() );
+                    g->u.grab( OBJECT_NONE );
+                }
+                transparency_changed |= old_f.transparent != new_f.transparent;
+                outside_changed |= old_f.has_flag( TFLAG_INDOORS ) !=
+                                   new_f.has_flag( TFLAG_INDOORS );
+                floor_changed |= old_f.has_flag( TFLAG_NO_FLOOR ) !=
+                                 new_f.has_flag( TFLAG_NO_FLOOR );
+                set_memory_seen_cache_dirty( q );
+                support_dirty( q );
+                support_dirty( above );
+                changed = true;
+            }
+            if( set_ter && current_submap->get_ter( l ) != new_terrain ) {
+                const ter_t &old_t = current_submap->get_ter( l ).obj();
+                current_submap->set_ter( l, new_terrain );
+                // Hack around ledges in traplocs or else it gets NASTY in z-level mode
+                if( old_t.trap != tr_null && old_t.trap != tr_ledge ) {
+                    auto &traps = traplocs[old_t.trap];
+                    const auto iter = std::find( traps.begin(), traps.end(), q );
+                    if( iter != traps.end() ) {
+                        traps.erase( iter );
+                    }
+                }
+                if( new_t.trap != tr_null && new_t.trap != tr_ledge ) {
+                    traplocs[new_t.trap].push_back( q );
+                }
+                heat_changed |= old_t.trap == tr_lava || new_t.trap == tr_lava;
+                transparency_changed |= old_t.transparent != new_t.transparent;
+                outside_changed |= old_t.has_flag( TFLAG_INDOORS ) !=
+                                   new_t.has_flag( TFLAG_INDOORS );
+                if( new_t.has_flag( TFLAG_NO_FLOOR ) && !old_t.has_flag( TFLAG_NO_FLOOR ) ) {
+                    floor_changed = true;
+                    // It's a set, not a flag
+                    support_cache_dirty.insert( q );
+                }
+                set_memory_seen_cache_dirty( q );
+                support_dirty( above );
+                changed = true;
+            }
+        }
+    }
+
+    if( !changed ) {
+        return;
+    }
+    if( heat_changed ) {
+        set_heat_cache_dirty( p.z );
+    }
+    if( transparency_changed ) {
+        set_transparency_cache_dirty( p.z );
+    }
+    if( outside_changed ) {
+        set_outside_cache_dirty( p.z );
+    }
+    if( floor_changed ) {
+        set_floor_cache_dirty( p.z );
+    }
+    set_pathfinding_cache_dirty( p.z );
+}
+
 std::string map::name( const tripoint &p )
 {
     return has_furn( p ) ? furnname( p ) : tername( p );
@@ -1469,6 +1602,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
         traplocs[new_t.trap].push_back( p );
     }
 
+    if( old_t.trap == tr_lava || new_t.trap == tr_lava ) {
+        set_heat_cache_dirty( p.z );
+    }
+
     if( old_t.transparent != new_t.transparent ) {
         set_transparency_cache_dirty( p.z );
     }
@@ -3970,7 +4107,7 @@ map_stack map::i_at( const int x, const int y )
     return map_stack{ &current_submap->itm[l.x][l.y], tripoint( p, abs_sub.z ), this };
 }
 
-std::list<item>::iterator map::i_rem( const point &location, std::list<item>::iterator it )
+item_stack::iterator map::i_rem( const point &location, item_stack::iterator it )
 {
     return i_rem( tripoint( location, abs_sub.z ), it );
 }
@@ -4034,7 +4171,7 @@ map_stack map::i_at( const tripoint &p )
     return map_stack{ &current_submap->itm[l.x][l.y], p, this };
 }
 
-std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterator it )
+item_stack::iterator map::i_rem( const tripoint &p, item_stack::iterator it )
 {
     point l;
     submap *const current_submap = get_submap_at( p, l );
@@ -4044,6 +4181,7 @@ std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterat
     }
 
     current_submap->update_lum_rem( l, *it );
+    current_submap->items_changed( l );
 
     return current_submap->itm[l.x][l.y].erase( it );
 }
@@ -4093,6 +4231,7 @@ void map::i_clear( const tripoint &p )
 
     current_submap->lum[l.x][l.y] = 0;
     current_submap->itm[l.x][l.y].clear();
+    current_submap->items_changed( l );
 }
 
 item &map::spawn_an_item( const tripoint &p, item new_item,
@@ -4288,7 +4427,7 @@ item &map::add_item( const tripoint &p, item new_item )
 }
 
 item &map::add_item_at( const tripoint &p,
-                        std::list<item>::iterator index, item new_item )
+                        item_stack::iterator index, item new_item )
 {
     if( new_item.made_of( LIQUID ) && has_flag( "SWIMMABLE", p ) ) {
         return null_item_reference();
@@ -4315,6 +4454,7 @@ item &map::add_item_at( const tripoint &p,
     }
 
     current_submap->update_lum_add( l, new_item );
+    current_submap->items_changed( l );
     const auto new_pos = current_submap->itm[l.x][l.y].insert( index, new_item );
     if( new_item.needs_processing() ) {
         current_submap->active_items.add( new_pos, l );
@@ -4417,7 +4557,7 @@ static bool item_is_in_activity( const item *it )
     } ) != targs->end();
 }
 
-static bool process_item( item_stack &items, std::list<item>::iterator &n, const tripoint &location,
+static bool process_item( item_stack &items, item_stack::iterator &n, const tripoint &location,
                           const bool activate, const int temp, const float insulation )
 {
     if( !item_is_in_activity( &*n ) ) {
@@ -4444,7 +4584,7 @@ static bool process_item( item_stack &items, std::list<item>::iterator &n, const
     return false;
 }
 
-static bool process_map_items( item_stack &items, std::list<item>::iterator &n,
+static bool process_map_items( item_stack &items, item_stack::iterator &n,
                                const tripoint &location, const std::string &, const int temp,
                                const float insulation )
 {
@@ -4544,7 +4684,7 @@ void map::process_items_in_submap( submap &current_submap, const tripoint &gridp
     // Get a COPY of the active item list for this submap.
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
-    std::list<item_reference> active_items = current_submap.active_items.get();
+    std::vector<item_reference> active_items = current_submap.active_items.get();
     const auto grid_offset = point {gridp.x * SEEX, gridp.y * SEEY};
     for( auto &active_item : active_items ) {
         if( !current_submap.active_items.has( active_item ) ) {
@@ -4697,6 +4837,18 @@ bool map::has_items( const tripoint &p ) const
     return !current_submap->itm[l.x][l.y].empty();
 }
 
+uint64_t map::item_stamp( const tripoint &p ) const
+{
+    if( !inbounds( p ) ) {
+        return 0;
+    }
+
+    point l;
+    submap *const current_submap = get_submap_at( p, l );
+
+    return current_submap->item_stamp[l.x][l.y];
+}
+
 template <typename Stack>
 std::list<item> use_amount_stack( Stack stack, const itype_id type, long &quantity,
                                   const std::function<bool( const item & )> &filter )
@@ -5056,7 +5208,7 @@ std::list<std::pair<tripoint, item *> > map::get_rc_items( int x, int y, int z )
     return rc_pairs;
 }
 
-static bool trigger_radio_item( item_stack &items, std::list<item>::iterator &n,
+static bool trigger_radio_item( item_stack &items, item_stack::iterator &n,
                                 const tripoint &pos, const std::string &signal,
                                 const int, const float )
 {
@@ -5164,6 +5316,9 @@ void map::trap_set( const tripoint &p, const trap_id type )
     if( type != tr_null ) {
         traplocs[type].push_back( p );
     }
+    if( type == tr_lava ) {
+        set_heat_cache_dirty( p.z );
+    }
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5231,6 +5386,9 @@ void map::remove_trap( const tripoint &p )
         }
 
         current_submap->set_trap( l, tr_null );
+        if( tid == tr_lava ) {
+            set_heat_cache_dirty( p.z );
+        }
         auto &traps = traplocs[tid];
         const auto iter = std::find( traps.begin(), traps.end(), p );
         if( iter != traps.end() ) {
@@ -5301,6 +5459,9 @@ int map::set_field_strength( const tripoint &p, const field_id type, const int s
         int adj = ( isoffset ? field_ptr->getFieldDensity() : 0 ) + str;
         if( adj > 0 ) {
             field_ptr->setFieldDensity( adj );
+            if( type == fd_fire ) {
+                set_heat_cache_dirty( p.z );
+            }
             return adj;
         } else {
             remove_field( p, type );
@@ -5394,6 +5555,9 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
     if( current_submap->fld[l.x][l.y].removeField( field_to_remove ) ) {
         // Only adjust the count if the field actually existed.
         current_submap->field_count--;
+        if( field_to_remove == fd_fire ) {
+            set_heat_cache_dirty( p.z );
+        }
         const auto &fdata = fieldlist[ field_to_remove ];
         for( bool i : fdata.transparent ) {
             if( !i ) {
@@ -6972,6 +7136,23 @@ void map::decay_cosmetic_fields( const tripoint &p, const time_duration &time_si
     }
 }
 
+void map::burn_out_fires( const tripoint &p, const time_duration &time_since_last_actualize )
+{
+    field_entry *fire = get_field( p, fd_fire );
+    if( fire == nullptr ) {
+        return;
+    }
+
+    fire->mod_age( time_since_last_actualize );
+    const time_duration hl = fieldlist[ fd_fire ].halflife;
+    const int density_drop = fire->getFieldAge() / hl;
+    if( density_drop > 0 ) {
+        fire->mod_age( -hl * density_drop );
+        // Removes the fire once it has died down completely
+        adjust_field_strength( p, fd_fire, -density_drop );
+    }
+}
+
 void map::actualize( const int gridx, const int gridy, const int gridz )
 {
     submap *const tmpsub = get_submap_at_grid( {gridx, gridy, gridz} );
@@ -6982,17 +7163,15 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
 
     const time_duration time_since_last_actualize = calendar::turn - tmpsub->last_touched;
     const bool do_funnels = ( gridz >= 0 );
+    // Submaps that were generated or last actualized this very turn have nothing to catch up on.
+    const bool do_catch_up = time_since_last_actualize > 0_turns;
+    const bool has_fields = tmpsub->field_count > 0;
 
     // check spoiled stuff, and fill up funnels while we're at it
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
             const tripoint pnt( gridx * SEEX + x, gridy * SEEY + y, gridz );
             const point p( x, y );
-            const auto &furn = this->furn( pnt ).obj();
-            // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
-                remove_rotten_items( tmpsub->itm[x][y], pnt );
-            }
 
             const auto trap_here = tmpsub->get_trap( p );
             if( trap_here != tr_null ) {
@@ -7003,6 +7182,16 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
                 traplocs[trap_here].push_back( pnt );
             }
 
+            if( !do_catch_up ) {
+                continue;
+            }
+
+            const auto &furn = this->furn( pnt ).obj();
+            // plants contain a seed item which must not be removed under any circumstances
+            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
+                remove_rotten_items( tmpsub->itm[x][y], pnt );
+            }
+
             if( do_funnels ) {
                 fill_funnels( pnt, tmpsub->last_touched );
             }
@@ -7015,7 +7204,10 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
 
             rad_scorch( pnt, time_since_last_actualize );
 
-            decay_cosmetic_fields( pnt, time_since_last_actualize );
+            if( has_fields ) {
+                decay_cosmetic_fields( pnt, time_since_last_actualize );
+                burn_out_fires( pnt, time_since_last_actualize );
+            }
         }
     }
 
@@ -7305,6 +7497,11 @@ void map::clear_traps()
     for( auto &i : traplocs ) {
         i.clear();
     }
+
+    // Lava might have been among them
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        set_heat_cache_dirty( z );
+    }
 }
 
 const std::vector<tripoint> &map::trap_locations( const trap_id type ) const
@@ -8146,7 +8343,8 @@ std::list<item_location> map::get_active_items_in_radius( const tripoint &center
         for( int gy = ming.y; gy <= maxg.y; ++gy ) {
             const point sm_offset( gx * SEEX, gy * SEEY );
 
-            for( const auto &elem : get_submap_at_grid( { gx, gy, center.z } )->active_items.get() ) {
+            const submap *sm = get_submap_at_grid( { gx, gy, center.z } );
+            for( const auto &elem : sm->active_items.get_all() ) {
                 const tripoint pos( sm_offset + elem.location, center.z );
 
                 if( rl_dist( pos, center ) > radius ) {
@@ -8161,6 +8359,39 @@ std::list<item_location> map::get_active_items_in_radius( const tripoint &center
     return result;
 }
 
+const std::vector<std::pair<tripoint, item *>> &map::get_active_items_on_level( const int zlev )
+{
+    auto &map_cache = get_cache( zlev );
+    auto &result = map_cache.active_item_list;
+    auto &stamps = map_cache.active_item_list_stamps;
+    // Items may also come and go through other maps sharing the submaps, so it's the submaps
+    // that tell whether the list is still good
+    bool changed = stamps.size() != static_cast<size_t>( my_MAPSIZE * my_MAPSIZE );
+    for( size_t i = 0; !changed && i < stamps.size(); ++i ) {
+        const tripoint grid( i / my_MAPSIZE, i % my_MAPSIZE, zlev );
+        changed = get_submap_at_grid( grid )->active_items.stamp() != stamps[i];
+    }
+    if( !changed ) {
+        return result;
+    }
+
+    result.clear();
+    stamps.clear();
+    for( int gx = 0; gx < my_MAPSIZE; ++gx ) {
+        for( int gy = 0; gy < my_MAPSIZE; ++gy ) {
+            const point sm_offset( gx * SEEX, gy * SEEY );
+            const submap *sm = get_submap_at_grid( { gx, gy, zlev } );
+            stamps.push_back( sm->active_items.stamp() );
+            for( const auto &elem : sm->active_items.get_all() ) {
+                result.emplace_back( tripoint( sm_offset + elem.location, zlev ),
+                                     &*elem.item_iterator );
+            }
+        }
+    }
+
+    return result;
+}
+
 level_cache &map::access_cache( int zlev )
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
@@ -8187,6 +8418,7 @@ level_cache::level_cache()
     transparency_cache_dirty = true;
     outside_cache_dirty = true;
     floor_cache_dirty = false;
+    heat_cache_dirty = true;
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
@@ -8197,6 +8429,9 @@ level_cache::level_cache()
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, LL_DARK );
+    std::fill_n( &radiant_heat_cache[0][0], map_dimensions, 0 );
+    std::fill_n( &direct_heat_cache[0][0], map_dimensions, 0 );
+    std::fill_n( &heat_source_buffer[0][0], map_dimensions, 0.0f );
     veh_in_active_range = false;
     std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
 }
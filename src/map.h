@@ -4,6 +4,7 @@
 
 #include <array>
 #include <bitset>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
@@ -113,11 +114,11 @@ class map_stack : public item_stack
         tripoint location;
         map *myorigin;
     public:
-        map_stack( std::list<item> *newstack, tripoint newloc, map *neworigin ) :
+        map_stack( item_list *newstack, tripoint newloc, map *neworigin ) :
             item_stack( newstack ), location( newloc ), myorigin( neworigin ) {}
-        std::list<item>::iterator erase( std::list<item>::iterator it ) override;
+        iterator erase( iterator it ) override;
         void push_back( const item &newitem ) override;
-        void insert_at( std::list<item>::iterator index, const item &newitem ) override;
+        void insert_at( iterator index, const item &newitem ) override;
         int count_limit() const override {
             return MAX_ITEM_IN_SQUARE;
         }
@@ -167,6 +168,7 @@ struct level_cache {
     bool transparency_cache_dirty;
     bool outside_cache_dirty;
     bool floor_cache_dirty;
+    bool heat_cache_dirty;
 
     four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
     float sm[MAPSIZE_X][MAPSIZE_Y];
@@ -179,11 +181,27 @@ struct level_cache {
     float seen_cache[MAPSIZE_X][MAPSIZE_Y];
     float camera_cache[MAPSIZE_X][MAPSIZE_Y];
     lit_level visibility_cache[MAPSIZE_X][MAPSIZE_Y];
+    // Heat radiated onto each tile by visible fire and lava, see map::build_heat_cache
+    int radiant_heat_cache[MAPSIZE_X][MAPSIZE_Y];
+    // Intensity of the strongest heat source adjacent to (or on) each tile
+    int direct_heat_cache[MAPSIZE_X][MAPSIZE_Y];
+    // Line of sight from a single heat source. Only valid for the duration of build_heat_cache
+    float heat_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    // Positions of all fires, sorted by x then y. Gathered along with the heat cache
+    std::vector<point> fire_cache;
+    // Active items lying on this level, see map::get_active_items_on_level
+    std::vector<std::pair<tripoint, item *>> active_item_list;
+    // Stamps of the active item caches of the submaps the list was built from, see
+    // active_item_cache::stamp. Any submap can change them, not only this map.
+    std::vector<unsigned long long> active_item_list_stamps;
     std::bitset<MAPSIZE_X *MAPSIZE_Y> map_memory_seen_cache;
 
     bool veh_in_active_range;
     bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
     std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
+    // Area covered by the cached parts of each vehicle. Used to find the parts of a vehicle
+    // again without searching the whole cache and as broadphase for vehicle collisions.
+    std::map<vehicle *, rectangle> veh_cached_areas;
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
 };
@@ -233,6 +251,14 @@ class map
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 get_cache( zlev ).transparency_cache_dirty = true;
+                // Line of sight to heat sources may have changed
+                get_cache( zlev ).heat_cache_dirty = true;
+            }
+        }
+
+        void set_heat_cache_dirty( const int zlev ) {
+            if( inbounds_z( zlev ) ) {
+                get_cache( zlev ).heat_cache_dirty = true;
             }
         }
 
@@ -513,6 +539,13 @@ class map
         void update_vehicle_cache( vehicle *, int old_zlevel );
         void reset_vehicle_cache( int zlev );
         void clear_vehicle_cache( int zlev );
+        /**
+         * Cached areas of the vehicles on the z-level that overlap the given area, except for
+         * the one to ignore. No part of any other vehicle is outside of these areas, so tiles
+         * outside of them can't contain a vehicle.
+         */
+        std::vector<rectangle> get_vehicle_areas( const rectangle &area, int zlev,
+                const vehicle *ignore ) const;
         void clear_vehicle_list( int zlev );
         void update_vehicle_list( submap *const to, const int zlev );
         //Returns true if vehicle zones are dirty and need to be recached
@@ -623,6 +656,13 @@ class map
         ter_id get_ter_transforms_into( const tripoint &p ) const;
 
         bool ter_set( const tripoint &p, const ter_id &new_terrain );
+        /**
+         * Sets terrain and furniture of length squares in a row, starting at p and going east.
+         * Same as furn_set and ter_set on each of them, but the submap is looked up once per
+         * submap and the caches are marked dirty once. A null id leaves that part alone.
+         */
+        void set_row( const tripoint &p, int length, const ter_id &new_terrain,
+                      const furn_id &new_furniture );
 
         std::string tername( const tripoint &p ) const;
 
@@ -649,6 +689,11 @@ class map
          * Checks for existence of items. Faster than i_at(p).empty
          */
         bool has_items( const tripoint &p ) const;
+        /**
+         * Changes whenever items are added to or removed from the square, so results computed
+         * from its items can be reused while it stays the same. Returns 0 outside the map.
+         */
+        uint64_t item_stamp( const tripoint &p ) const;
 
         /**
          * Calls the examine function of furniture or terrain at given tile, for given character.
@@ -877,7 +922,7 @@ class map
         // Items: 2D
         map_stack i_at( int x, int y );
         void i_clear( const int x, const int y );
-        std::list<item>::iterator i_rem( const point &location, std::list<item>::iterator it );
+        item_stack::iterator i_rem( const point &location, item_stack::iterator it );
         int i_rem( const int x, const int y, const int index );
         void i_rem( const int x, const int y, item *it );
         void spawn_item( const int x, const int y, const std::string &itype_id,
@@ -902,7 +947,7 @@ class map
         void i_clear( const tripoint &p );
         // i_rem() methods that return values act like container::erase(),
         // returning an iterator to the next item after removal.
-        std::list<item>::iterator i_rem( const tripoint &p, std::list<item>::iterator it );
+        item_stack::iterator i_rem( const tripoint &p, item_stack::iterator it );
         int i_rem( const tripoint &p, const int index );
         void i_rem( const tripoint &p, const item *it );
         void spawn_artifact( const tripoint &p );
@@ -925,7 +970,7 @@ class map
         item &add_item_or_charges( const tripoint &pos, item obj, bool overflow = true );
 
         /** Helper for map::add_item */
-        item &add_item_at( const tripoint &p, std::list<item>::iterator index, item new_item );
+        item &add_item_at( const tripoint &p, item_stack::iterator index, item new_item );
         /**
          * Place an item on the map, despite the parameter name, this is not necessarily a new item.
          * WARNING: does -not- check volume or stack charges. player functions (drop etc) should use
@@ -1064,6 +1109,22 @@ class map
          * if there is no field of that type, returns 0.
          */
         int get_field_strength( const tripoint &p, const field_id type ) const;
+        /**
+         * Heat radiated onto the tile by all fire and lava in line of sight within 6 tiles.
+         * Read from the per-level heat cache, which is rebuilt lazily when heat sources
+         * or transparency change.
+         */
+        int get_radiant_heat( const tripoint &p );
+        /**
+         * Intensity of the strongest fire or lava on or adjacent to the tile,
+         * i.e. what one can warm up over by leaning in.
+         */
+        int get_direct_heat( const tripoint &p );
+        /**
+         * Positions of every fire on the z-level, sorted by x and then y coordinate.
+         * Gathered together with the heat cache, so it's only rebuilt when fires change.
+         */
+        const std::vector<point> &get_fire_positions( int zlev );
         /**
          * Increment/decrement age of field entry at point.
          * @return resulting age or `-1_turns` if not present (does *not* create a new field).
@@ -1331,6 +1392,9 @@ class map
         /**
          * Fast forward a submap that has just been loading into this map.
          * This is used to rot and remove rotten items, grow plants, fill funnels etc.
+         * Nothing in a submap is simulated while it is outside of the reality bubble,
+         * so everything that depends on time passing has to be caught up here in one
+         * closed-form step covering the time since submap::last_touched.
          */
         void actualize( int gridx, int gridy, int gridz );
         /**
@@ -1387,6 +1451,14 @@ class map
          */
         void rad_scorch( const tripoint &p, const time_duration &time_since_last_actualize );
         void decay_cosmetic_fields( const tripoint &p, const time_duration &time_since_last_actualize );
+        /**
+         * Fires aren't processed outside of the reality bubble. Instead of having them
+         * burn on forever, let them die down as if they had run out of fuel.
+         * @param p Location of the fire
+         * @param time_since_last_actualize Time since this function has been
+         * called the last time.
+         */
+        void burn_out_fires( const tripoint &p, const time_duration &time_since_last_actualize );
 
         void player_in_field( player &u );
         void monster_in_field( monster &z );
@@ -1404,6 +1476,7 @@ class map
                        const float density, const int zlevel, const regional_settings *rsettings );
 
         void build_transparency_cache( int zlev );
+        void build_heat_cache( int zlev );
     public:
         void build_outside_cache( int zlev );
         void build_floor_cache( int zlev );
@@ -1514,8 +1587,8 @@ class map
         void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
         void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
                               const tripoint &s, const tripoint &e, float luminance );
-        void add_light_from_items( const tripoint &p, std::list<item>::iterator begin,
-                                   std::list<item>::iterator end );
+        void add_light_from_items( const tripoint &p, item_stack::iterator begin,
+                                   item_stack::iterator end );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh,
                 bool merge_wrecks );
 
@@ -1540,7 +1613,7 @@ class map
          * It's a really heinous function pointer so a typedef is the best
          * solution in this instance.
          */
-        typedef bool ( *map_process_func )( item_stack &, std::list<item>::iterator &, const tripoint &,
+        typedef bool ( *map_process_func )( item_stack &, item_stack::iterator &, const tripoint &,
                                             const std::string &, int, float );
     private:
 
@@ -1622,6 +1695,12 @@ class map
         tripoint_range points_in_radius( const tripoint &center, size_t radius, size_t radiusz = 0 ) const;
 
         std::list<item_location> get_active_items_in_radius( const tripoint &center, int radius ) const;
+        /**
+         * All active items lying on the z-level (not those in vehicles) and their positions,
+         * in the order @ref get_active_items_in_radius lists them. The list is rebuilt lazily
+         * once the active items of one of the submaps changed, don't hold on to it.
+         */
+        const std::vector<std::pair<tripoint, item *>> &get_active_items_on_level( int zlev );
 
         level_cache &access_cache( int zlev );
         const level_cache &access_cache( int zlev ) const;
@@ -1,95 +1,185 @@
 #include "map_memory.h"
 
-template<typename T>
-T lru_cache<T>::get( const tripoint &pos, const T &default_ ) const
+#include <algorithm>
+#include <deque>
+#include <iterator>
+
+#include "coordinate_conversions.h"
+
+// Remembered tile ids are terrain, furniture, trap and vehicle part ids, so there are only
+// a few thousand of them. Each is stored once and referred to by its index.
+class tile_id_table
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        return found->second->second;
-    }
-    return default_;
+    public:
+        tile_id_table() {
+            intern( std::string() );
+        }
+
+        uint32_t intern( const std::string &id ) {
+            const auto found = index.find( id );
+            if( found != index.end() ) {
+                return found->second;
+            }
+            const uint32_t result = ids.size();
+            ids.push_back( id );
+            index.emplace( id, result );
+            return result;
+        }
+
+        const std::string &get( const uint32_t i ) const {
+            return ids[i];
+        }
+
+    private:
+        // A deque, so references handed out stay valid when new ids are added
+        std::deque<std::string> ids;
+        std::unordered_map<std::string, uint32_t> index;
+};
+
+static tile_id_table &tile_ids()
+{
+    static tile_id_table table;
+    return table;
 }
 
-template<typename T>
-void lru_cache<T>::remove( const tripoint &pos )
+static int chunk_limit( const int tile_limit )
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        ordered_list.erase( found->second );
-        map.erase( found );
-    }
+    constexpr int chunk_tiles = SEEX * SEEY;
+    return std::max( 1, tile_limit / chunk_tiles + ( tile_limit % chunk_tiles != 0 ? 1 : 0 ) );
+}
+
+uint32_t map_memory::intern_tile_id( const std::string &id )
+{
+    return tile_ids().intern( id );
+}
+
+const std::string &map_memory::tile_id( const uint32_t index )
+{
+    return tile_ids().get( index );
 }
 
-template<typename T>
-void lru_cache<T>::insert( int limit, const tripoint &pos, const T &t )
+map_memory::chunk::chunk( const tripoint &pos ) : pos( pos )
 {
-    auto found = map.find( pos );
+    std::fill( std::begin( tiles ), std::end( tiles ), 0 );
+    std::fill( std::begin( rotations ), std::end( rotations ), 0 );
+    std::fill( std::begin( subtiles ), std::end( subtiles ), 0 );
+    std::fill( std::begin( symbols ), std::end( symbols ), 0 );
+}
 
-    if( found == map.end() ) {
-        // Need new entry in map.  Make the new list entry and point to it.
-        ordered_list.emplace_back( pos, t );
-        map[pos] = std::prev( ordered_list.end() );
-        trim( limit );
-    } else {
-        // Splice existing entry to the back.  Does not invalidate the
-        // iterator, so no need to change the map.
-        auto list_iterator = found->second;
-        ordered_list.splice( ordered_list.end(), ordered_list, list_iterator );
-        // Update the moved item
-        list_iterator->second = t;
+map_memory::map_memory( const map_memory &other ) : chunks( other.chunks )
+{
+    for( auto it = chunks.begin(); it != chunks.end(); ++it ) {
+        chunk_at.emplace( it->pos, it );
     }
 }
 
-template<typename T>
-void lru_cache<T>::trim( int limit )
+map_memory &map_memory::operator=( const map_memory &other )
 {
-    while( map.size() > static_cast<size_t>( limit ) ) {
-        map.erase( ordered_list.front().first );
-        ordered_list.pop_front();
+    if( this != &other ) {
+        clear();
+        chunks = other.chunks;
+        for( auto it = chunks.begin(); it != chunks.end(); ++it ) {
+            chunk_at.emplace( it->pos, it );
+        }
     }
+    return *this;
 }
 
-template<typename T>
-void lru_cache<T>::clear()
+static tripoint chunk_pos( const tripoint &pos, int &index )
 {
-    map.clear();
-    ordered_list.clear();
+    int x = pos.x;
+    int y = pos.y;
+    const point sm = ms_to_sm_remain( x, y );
+    index = x + y * SEEX;
+    return tripoint( sm.x, sm.y, pos.z );
 }
 
-template<typename T>
-const std::list<typename lru_cache<T>::Pair> &lru_cache<T>::list() const
+const map_memory::chunk *map_memory::find_chunk( const tripoint &pos ) const
 {
-    return ordered_list;
+    if( last_chunk != nullptr && last_chunk_pos == pos ) {
+        return last_chunk;
+    }
+    const auto found = chunk_at.find( pos );
+    if( found == chunk_at.end() ) {
+        return nullptr;
+    }
+    last_chunk_pos = pos;
+    last_chunk = &*found->second;
+    return last_chunk;
 }
 
-template class lru_cache<memorized_terrain_tile>;
-template class lru_cache<long>;
+map_memory::chunk &map_memory::touch_chunk( const int limit, const tripoint &pos )
+{
+    const auto found = chunk_at.find( pos );
+    if( found != chunk_at.end() ) {
+        // Splicing keeps the iterator and the chunk address valid
+        chunks.splice( chunks.end(), chunks, found->second );
+        return *found->second;
+    }
+
+    const size_t max_chunks = chunk_limit( limit );
+    while( chunks.size() >= max_chunks ) {
+        if( last_chunk == &chunks.front() ) {
+            last_chunk = nullptr;
+        }
+        chunk_at.erase( chunks.front().pos );
+        chunks.pop_front();
+    }
+    chunks.emplace_back( pos );
+    chunk_at.emplace( pos, std::prev( chunks.end() ) );
+    return chunks.back();
+}
 
-static const memorized_terrain_tile default_tile{ "", 0, 0 };
+void map_memory::clear()
+{
+    chunks.clear();
+    chunk_at.clear();
+    last_chunk = nullptr;
+}
 
 memorized_terrain_tile map_memory::get_tile( const tripoint &pos ) const
 {
-    return tile_cache.get( pos, default_tile );
+    int i = 0;
+    const chunk *c = find_chunk( chunk_pos( pos, i ) );
+    if( c == nullptr ) {
+        return memorized_terrain_tile{ tile_id( 0 ), 0, 0 };
+    }
+    return memorized_terrain_tile{ tile_id( c->tiles[i] ), c->subtiles[i], c->rotations[i] };
 }
 
 void map_memory::memorize_tile( int limit, const tripoint &pos, const std::string &ter,
                                 const int subtile, const int rotation )
 {
-    tile_cache.insert( limit, pos, memorized_terrain_tile{ ter, subtile, rotation } );
+    int i = 0;
+    chunk &c = touch_chunk( limit, chunk_pos( pos, i ) );
+    c.tiles[i] = intern_tile_id( ter );
+    c.subtiles[i] = subtile;
+    c.rotations[i] = rotation;
 }
 
 long map_memory::get_symbol( const tripoint &pos ) const
 {
-    return symbol_cache.get( pos, 0 );
+    int i = 0;
+    const chunk *c = find_chunk( chunk_pos( pos, i ) );
+    return c == nullptr ? 0 : c->symbols[i];
 }
 
 void map_memory::memorize_symbol( int limit, const tripoint &pos, const long symbol )
 {
-    symbol_cache.insert( limit, pos, symbol );
+    int i = 0;
+    touch_chunk( limit, chunk_pos( pos, i ) ).symbols[i] = symbol;
 }
 
 void map_memory::clear_memorized_tile( const tripoint &pos )
 {
-    tile_cache.remove( pos );
-    symbol_cache.remove( pos );
+    int i = 0;
+    const auto found = chunk_at.find( chunk_pos( pos, i ) );
+    if( found == chunk_at.end() ) {
+        return;
+    }
+    chunk &c = *found->second;
+    c.tiles[i] = 0;
+    c.subtiles[i] = 0;
+    c.rotations[i] = 0;
+    c.symbols[i] = 0;
 }
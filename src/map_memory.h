@@ -2,50 +2,48 @@
 #ifndef MAP_MEMORY_H
 #define MAP_MEMORY_H
 
+#include <cstdint>
 #include <list>
 #include <string>
 #include <unordered_map>
 
 #include "enums.h" // IWYU pragma: keep
+#include "game_constants.h"
 
 class JsonOut;
 class JsonObject;
+class JsonIn;
 
 struct memorized_terrain_tile {
-    std::string tile;
+    /** Interned tile id, stays valid for the lifetime of the program. */
+    const std::string &tile;
     int subtile;
     int rotation;
 };
 
-template<typename T>
-class lru_cache
-{
-    public:
-        using Pair = std::pair<tripoint, T>;
-
-        void insert( int limit, const tripoint &, const T & );
-        T get( const tripoint &, const T &default_ ) const;
-        void remove( const tripoint & );
-
-        void clear();
-        const std::list<Pair> &list() const;
-    private:
-        void trim( int limit );
-        std::list<Pair> ordered_list;
-        std::unordered_map<tripoint, typename std::list<Pair>::iterator> map;
-};
-
-extern template class lru_cache<memorized_terrain_tile>;
-extern template class lru_cache<long>;
-
+/**
+ * The map as the player remembers it.
+ *
+ * Memory is kept in chunks covering one submap each, the tiles of a chunk are stored in plain
+ * arrays of interned tile ids, subtiles, rotations and curses symbols. Whole chunks are
+ * forgotten in least recently used order once the memory is full, so drawing a remembered
+ * area only touches a handful of chunks and never has to hash individual tiles.
+ */
 class map_memory
 {
     public:
+        map_memory() = default;
+        map_memory( const map_memory & );
+        map_memory &operator=( const map_memory & );
+
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin );
         void load( JsonObject &jsin );
 
-        /** Memorizes a given tile; finalize_tile_memory needs to be called after it */
+        /**
+         * Memorizes a given tile; finalize_tile_memory needs to be called after it.
+         * @param limit Maximal number of remembered tiles, it's rounded up to whole chunks.
+         */
         void memorize_tile( int limit, const tripoint &pos, const std::string &ter,
                             const int subtile, const int rotation );
         /** Returns last stored map tile in given location */
@@ -55,9 +53,40 @@ class map_memory
         long get_symbol( const tripoint &pos ) const;
 
         void clear_memorized_tile( const tripoint &pos );
+
+        /** Number of chunks (submaps) that are currently remembered. */
+        size_t chunk_count() const {
+            return chunks.size();
+        }
+
     private:
-        lru_cache<memorized_terrain_tile> tile_cache;
-        lru_cache<long> symbol_cache;
+        static constexpr int chunk_tiles = SEEX * SEEY;
+
+        struct chunk {
+            explicit chunk( const tripoint &pos );
+
+            tripoint pos;
+            uint32_t tiles[chunk_tiles];
+            int16_t rotations[chunk_tiles];
+            int8_t subtiles[chunk_tiles];
+            int32_t symbols[chunk_tiles];
+        };
+
+        static uint32_t intern_tile_id( const std::string &id );
+        static const std::string &tile_id( uint32_t index );
+
+        /** Chunk containing pos or nullptr, doesn't change the eviction order. */
+        const chunk *find_chunk( const tripoint &pos ) const;
+        /** Chunk containing pos, created if needed and marked as most recently used. */
+        chunk &touch_chunk( int limit, const tripoint &pos );
+        void clear();
+
+        // Oldest chunk first
+        std::list<chunk> chunks;
+        std::unordered_map<tripoint, std::list<chunk>::iterator> chunk_at;
+        // Tiles are looked up a submap row at a time while drawing, so remember the last chunk.
+        mutable tripoint last_chunk_pos;
+        mutable const chunk *last_chunk = nullptr;
 };
 
 #endif
@@ -34,6 +34,7 @@ void mapbuffer::reset()
         delete elem.second;
     }
     submaps.clear();
+    active_vehicle_submaps.clear();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
@@ -43,6 +44,12 @@ bool mapbuffer::add_submap( const tripoint &p, submap *sm )
     }
 
     submaps[p] = sm;
+    for( const auto &veh : sm->vehicles ) {
+        if( veh->is_active_off_map() ) {
+            add_active_vehicle_submap( p );
+            break;
+        }
+    }
 
     return true;
 }
@@ -73,6 +80,22 @@ void mapbuffer::remove_submap( tripoint addr )
     }
     delete m_target->second;
     submaps.erase( m_target );
+    remove_active_vehicle_submap( addr );
+}
+
+void mapbuffer::remove_unused_submap( const tripoint &p )
+{
+    remove_submap( p );
+}
+
+void mapbuffer::add_active_vehicle_submap( const tripoint &p )
+{
+    active_vehicle_submaps.insert( p );
+}
+
+void mapbuffer::remove_active_vehicle_submap( const tripoint &p )
+{
+    active_vehicle_submaps.erase( p );
 }
 
 submap *mapbuffer::lookup_submap( int x, int y, int z )
@@ -5,6 +5,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "enums.h"
@@ -58,6 +59,28 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
+        /** Delete a submap that is not loaded into any map, e.g. one that was only
+         * added with @ref add_submap and never looked at again. Submaps that a map still
+         * uses must not be removed this way.
+         */
+        void remove_unused_submap( const tripoint &p );
+
+        /**
+         * Submaps that contain vehicles which keep running while nobody is around, see
+         * @ref vehicle::is_active_off_map. Outside of the reality bubble only the vehicles on
+         * these submaps need per-turn processing, so the cost of that does not grow with the
+         * number of submaps in the buffer.
+         *
+         * Submaps are added when they are stored in the buffer and by the turn processing of
+         * the reality bubble. They are removed lazily, when processing finds nothing active on
+         * them any more, or when the submap itself is removed from the buffer.
+         */
+        const std::set<tripoint> &get_active_vehicle_submaps() const {
+            return active_vehicle_submaps;
+        }
+        void add_active_vehicle_submap( const tripoint &p );
+        void remove_active_vehicle_submap( const tripoint &p );
+
     private:
         typedef std::map<tripoint, submap *> submap_map_t;
 
@@ -79,6 +102,7 @@ class mapbuffer
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
+        std::set<tripoint> active_vehicle_submaps;
 };
 
 extern mapbuffer MAPBUFFER;
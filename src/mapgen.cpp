@@ -1,6 +1,7 @@
 #include "mapgen.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <list>
@@ -246,9 +247,9 @@ std::map<std::string, std::vector<std::shared_ptr<update_mapgen_function_json>>
 std::map<std::string, std::map<int, int> > oter_mapgen_weights;
 
 /*
- * setup oter_mapgen_weights which mapgen uses to diceroll. Also setup mapgen_function_json
+ * setup oter_mapgen_weights which mapgen uses to diceroll. Json mapgen is set up on first use.
  */
-void calculate_mapgen_weights()   // TODO: rename as it runs jsonfunction setup too
+void calculate_mapgen_weights()
 {
     oter_mapgen_weights.clear();
     for( auto &omw : oter_mapgen ) {
@@ -264,29 +265,37 @@ void calculate_mapgen_weights()   // TODO: rename as it runs jsonfunction setup
                 ++funcnum;
                 continue; // rejected!
             }
-            ( *fit )->setup();
             wtotal += weight;
             oter_mapgen_weights[ omw.first ][ wtotal ] = funcnum;
             dbg( D_INFO ) << "wcalc " << omw.first << "(" << funcnum << "): +" << weight << " = " << wtotal;
             ++funcnum;
         }
     }
-    // Not really calculate weights, but let's keep it here for now
-    for( auto &pr : nested_mapgen ) {
-        for( auto &ptr : pr.second ) {
-            ptr->setup();
-        }
-    }
-    for( auto &pr : update_mapgen ) {
-        for( auto &ptr : pr.second ) {
-            ptr->setup();
-        }
-    }
-
 }
 
 void check_mapgen_definitions()
 {
+    // Setting up all json mapgen takes a while and most of it is never used in a game, so it's
+    // only done up front when testing. Otherwise only what has been used so far is checked.
+    if( test_mode ) {
+        for( auto &omw : oter_mapgen ) {
+            for( auto &ptr : omw.second ) {
+                if( ptr->weight >= 1 ) {
+                    ptr->setup();
+                }
+            }
+        }
+        for( auto &pr : nested_mapgen ) {
+            for( auto &ptr : pr.second ) {
+                ptr->setup();
+            }
+        }
+        for( auto &pr : update_mapgen ) {
+            for( auto &ptr : pr.second ) {
+                ptr->setup();
+            }
+        }
+    }
     for( auto &oter_definition : oter_mapgen ) {
         for( auto &mapgen_function_ptr : oter_definition.second ) {
             mapgen_function_ptr->check( oter_definition.first );
@@ -1715,7 +1724,9 @@ class jmapgen_nested : public jmapgen_piece
                 return;
             }
 
-            ptr->nest( dat, x.get(), y.get(), d );
+            if( ptr->setup_lazily() ) {
+                ptr->nest( dat, x.get(), y.get(), d );
+            }
         }
 };
 
@@ -2175,10 +2186,51 @@ void update_mapgen_function_json::setup()
     setup_common();
 }
 
+namespace
+{
+// Json mapgen is set up on first use, which can happen on any thread generating a map.
+// It happens rarely and is quick, so a spin lock will do.
+std::atomic_flag mapgen_setup_lock = ATOMIC_FLAG_INIT;
+
+class mapgen_setup_guard
+{
+    public:
+        mapgen_setup_guard() {
+            while( mapgen_setup_lock.test_and_set( std::memory_order_acquire ) ) {
+            }
+        }
+        ~mapgen_setup_guard() {
+            mapgen_setup_lock.clear( std::memory_order_release );
+        }
+        mapgen_setup_guard( const mapgen_setup_guard & ) = delete;
+        mapgen_setup_guard &operator=( const mapgen_setup_guard & ) = delete;
+};
+} // namespace
+
+void mapgen_function_json_base::setup_common()
+{
+    const mapgen_setup_guard guard;
+    setup_json();
+}
+
+bool mapgen_function_json_base::setup_lazily()
+{
+    const mapgen_setup_guard guard;
+    if( !is_ready && !setup_failed ) {
+        try {
+            setup_json();
+        } catch( const std::exception &err ) {
+            setup_failed = true;
+            debugmsg( "Failed to set up json mapgen: %s", err.what() );
+        }
+    }
+    return is_ready;
+}
+
 /*
  * Parse json, pre-calculating values for stuff, then cheerfully throw json away. Faster than regular mapf, in theory
  */
-void mapgen_function_json_base::setup_common()
+void mapgen_function_json_base::setup_json()
 {
     if( is_ready ) {
         return;
@@ -2255,6 +2307,7 @@ bool mapgen_function_json_base::setup_common( JsonObject jo )
         }
         qualifies = true;
         do_format = true;
+        compile_format();
     }
 
     // No fill_ter? No format? GTFO.
@@ -2292,6 +2345,7 @@ bool mapgen_function_json_base::setup_common( JsonObject jo )
     objects.load_objects<jmapgen_nested>( jo, "place_nested" );
     objects.load_objects<jmapgen_graffiti>( jo, "place_graffiti" );
     objects.load_objects<jmapgen_translate>( jo, "translate_ter" );
+    objects.compile();
 
     if( !mapgen_defer::defer ) {
         is_ready = true; // skip setup attempts from any additional pointers
@@ -2511,9 +2565,41 @@ bool jmapgen_setmap::has_vehicle_collision( const mapgendata &dat, int offset_x,
 }
 
 
+bool mapgen_uncompiled = false;
+
+void mapgen_function_json_base::compile_format()
+{
+    format_runs.clear();
+    for( size_t y = 0; y < mapgensize_y; y++ ) {
+        for( size_t x = 0; x < mapgensize_x; ) {
+            const ter_furn_id &first = format[calc_index( x, y )];
+            size_t end = x + 1;
+            while( end < mapgensize_x && format[calc_index( end, y )].ter == first.ter &&
+                   format[calc_index( end, y )].furn == first.furn ) {
+                end++;
+            }
+            if( first.ter != t_null || first.furn != f_null ) {
+                format_runs.push_back( format_run{
+                    static_cast<int>( x ), static_cast<int>( y ), static_cast<int>( end - x ),
+                    first.ter, first.furn
+                } );
+            }
+            x = end;
+        }
+    }
+}
+
 void mapgen_function_json_base::formatted_set_incredibly_simple( map &m, int offset_x,
         int offset_y ) const
 {
+    if( !mapgen_uncompiled ) {
+        const int z = m.get_abs_sub().z;
+        for( const format_run &run : format_runs ) {
+            m.set_row( tripoint( run.x + offset_x, run.y + offset_y, z ), run.length, run.ter,
+                       run.furn );
+        }
+        return;
+    }
     for( size_t y = 0; y < mapgensize_y; y++ ) {
         for( size_t x = 0; x < mapgensize_x; x++ ) {
             const size_t index = calc_index( x, y );
@@ -2539,6 +2625,9 @@ void mapgen_function_json_base::formatted_set_incredibly_simple( map &m, int off
 void mapgen_function_json::generate( map *m, const oter_id &terrain_type, const mapgendata &md,
                                      const time_point &, float d )
 {
+    if( !setup_lazily() ) {
+        return;
+    }
     if( fill_ter != t_null ) {
         m->draw_fill_background( fill_ter );
     }
@@ -2580,39 +2669,58 @@ void mapgen_function_json_nested::nest( const mapgendata &dat, int offset_x, int
 /*
  * Apply mapgen as per a derived-from-json recipe; in theory fast, but not very versatile
  */
-void jmapgen_objects::apply( const mapgendata &dat, float density, mission *miss ) const
+void jmapgen_objects::compile()
 {
-    for( auto &obj : objects ) {
-        const auto &where = obj.first;
-        const auto &what = *obj.second;
-        // The user will only specify repeat once in JSON, but it may get loaded both
-        // into the what and where in some cases--we just need the greater value of the two.
-        const int repeat = std::max( where.repeat.get(), what.repeat.get() );
-        for( int i = 0; i < repeat; i++ ) {
-            what.apply( dat, where.x, where.y, density, miss );
-        }
+    placements.clear();
+    for( const jmapgen_obj &obj : objects ) {
+        const jmapgen_place &where = obj.first;
+        const jmapgen_piece &what = *obj.second;
+        const bool random_repeat = where.repeat.val != where.repeat.valmax ||
+                                   what.repeat.val != what.repeat.valmax;
+        placements.push_back( placement{
+            &what, where, random_repeat, std::max( where.repeat.val, what.repeat.val )
+        } );
     }
 }
 
+void jmapgen_objects::apply( const mapgendata &dat, float density, mission *miss ) const
+{
+    apply( dat, 0, 0, density, miss );
+}
+
 void jmapgen_objects::apply( const mapgendata &dat, int offset_x, int offset_y,
                              float density, mission *miss ) const
 {
-    if( offset_x == 0 && offset_y == 0 ) {
-        // It's a bit faster
-        apply( dat, density, miss );
+    if( mapgen_uncompiled ) {
+        for( auto &obj : objects ) {
+            auto where = obj.first;
+            where.offset( -offset_x, -offset_y );
+
+            const auto &what = *obj.second;
+            // The user will only specify repeat once in JSON, but it may get loaded both
+            // into the what and where in some cases--we just need the greater value of the two.
+            const int repeat = std::max( where.repeat.get(), what.repeat.get() );
+            for( int i = 0; i < repeat; i++ ) {
+                what.apply( dat, where.x, where.y, density, miss );
+            }
+        }
         return;
     }
 
-    for( auto &obj : objects ) {
-        auto where = obj.first;
+    for( const placement &pl : placements ) {
+        const int repeat = pl.random_repeat ?
+                           std::max( pl.where.repeat.get(), pl.piece->repeat.get() ) : pl.repeat;
+        if( offset_x == 0 && offset_y == 0 ) {
+            // It's a bit faster
+            for( int i = 0; i < repeat; i++ ) {
+                pl.piece->apply( dat, pl.where.x, pl.where.y, density, miss );
+            }
+            continue;
+        }
+        jmapgen_place where = pl.where;
         where.offset( -offset_x, -offset_y );
-
-        const auto &what = *obj.second;
-        // The user will only specify repeat once in JSON, but it may get loaded both
-        // into the what and where in some cases--we just need the greater value of the two.
-        const int repeat = std::max( where.repeat.get(), what.repeat.get() );
         for( int i = 0; i < repeat; i++ ) {
-            what.apply( dat, where.x, where.y, density, miss );
+            pl.piece->apply( dat, where.x, where.y, density, miss );
         }
     }
 }
@@ -8673,7 +8781,8 @@ bool run_mapgen_update_func( const std::string update_mapgen_id, const tripoint
 {
     const auto update_function = update_mapgen.find( update_mapgen_id );
 
-    if( update_function == update_mapgen.end() || update_function->second.empty() ) {
+    if( update_function == update_mapgen.end() || update_function->second.empty() ||
+        !update_function->second[0]->setup_lazily() ) {
         return false;
     }
     return update_function->second[0]->update_map( omt_pos, 0, 0, miss, true );
@@ -259,6 +259,9 @@ struct jmapgen_objects {
 
         void check( const std::string &oter_name ) const;
 
+        /** Compiles the objects into @ref placements, once all of them are loaded. */
+        void compile();
+
         void apply( const mapgendata &dat, float density, mission *miss = nullptr ) const;
         void apply( const mapgendata &dat, int offset_x, int offset_y, float density,
                     mission *miss = nullptr ) const;
@@ -275,6 +278,18 @@ struct jmapgen_objects {
          */
         using jmapgen_obj = std::pair<jmapgen_place, std::shared_ptr<jmapgen_piece> >;
         std::vector<jmapgen_obj> objects;
+        /**
+         * An object as applied: in declaration order, so the rng is called as often and in
+         * the same order as when applying @ref objects, with a repeat that is not random
+         * already resolved.
+         */
+        struct placement {
+            const jmapgen_piece *piece;
+            jmapgen_place where;
+            bool random_repeat;
+            int repeat;
+        };
+        std::vector<placement> placements;
         int offset_x;
         int offset_y;
         size_t mapgensize_x;
@@ -286,9 +301,18 @@ class mapgen_function_json_base
     public:
         bool check_inbounds( const jmapgen_int &x, const jmapgen_int &y ) const;
         size_t calc_index( size_t x, size_t y ) const;
+        /**
+         * Sets the mapgen up on first use, may be called from any thread. Errors are reported
+         * with debugmsg instead of being thrown. Returns whether the mapgen can be used.
+         */
+        bool setup_lazily();
 
     private:
         std::string jdata;
+        // Set when setting up failed, so it isn't tried (and reported) again
+        bool setup_failed = false;
+
+        void setup_json();
 
     protected:
         mapgen_function_json_base( const std::string &s );
@@ -304,6 +328,8 @@ class mapgen_function_json_base
         void check_common( const std::string &oter_name ) const;
 
         void formatted_set_incredibly_simple( map &m, int offset_x, int offset_y ) const;
+        /** Compiles format into format_runs. */
+        void compile_format();
 
         bool do_format;
         bool is_ready;
@@ -313,6 +339,15 @@ class mapgen_function_json_base
         int x_offset;
         int y_offset;
         std::vector<ter_furn_id> format;
+        /** Squares of a row with the same terrain and furniture, drawn in one go. */
+        struct format_run {
+            int x;
+            int y;
+            int length;
+            ter_id ter;
+            furn_id furn;
+        };
+        std::vector<format_run> format_runs;
         std::vector<jmapgen_setmap> setmap_points;
 
         jmapgen_objects objects;
@@ -396,6 +431,19 @@ extern std::map<std::string, std::map<int, int> > oter_mapgen_weights;
 void calculate_mapgen_weights(); // throws
 
 void check_mapgen_definitions();
+/*
+ * json mapgen placed by other mapgen and by missions, by id
+ */
+extern std::map<std::string, std::vector<std::shared_ptr<mapgen_function_json_nested>> >
+        nested_mapgen;
+extern std::map<std::string, std::vector<std::shared_ptr<update_mapgen_function_json>> >
+        update_mapgen;
+/**
+ * Json mapgen draws its rows from runs of equal squares and applies its objects from a flat list
+ * of placements, both compiled during setup. When set, it runs from the rows and objects as
+ * parsed instead, tests compare the two.
+ */
+extern bool mapgen_uncompiled;
 
 /// move to building_generation
 enum room_type {
@@ -1,9 +1,13 @@
 #include "mongroup.h"
 
+#include <algorithm>
+
 #include "assign.h"
 #include "calendar.h"
 #include "debug.h"
+#include "game_constants.h"
 #include "json.h"
+#include "line.h"
 #include "mtype.h"
 #include "options.h"
 #include "rng.h"
@@ -76,6 +80,154 @@ float mongroup::avg_speed() const
     return avg_speed;
 }
 
+constexpr int mongroup_store::cell_size;
+
+tripoint mongroup_store::cell_of( const tripoint &p )
+{
+    // Round towards negative infinity, groups may lie outside of their overmap for a while
+    const auto cell = []( const int v ) {
+        return v >= 0 ? v / cell_size : ( v + 1 ) / cell_size - 1;
+    };
+    return tripoint( cell( p.x ), cell( p.y ), p.z );
+}
+
+void mongroup_store::add_to_cell( const size_t index )
+{
+    cells[cell_of( slots[index].indexed_pos )].push_back( index );
+}
+
+void mongroup_store::remove_from_cell( const size_t index )
+{
+    const auto cell = cells.find( cell_of( slots[index].indexed_pos ) );
+    if( cell == cells.end() ) {
+        return;
+    }
+    std::vector<size_t> &indices = cell->second;
+    const auto found = std::find( indices.begin(), indices.end(), index );
+    if( found != indices.end() ) {
+        *found = indices.back();
+        indices.pop_back();
+    }
+    if( indices.empty() ) {
+        cells.erase( cell );
+    }
+}
+
+void mongroup_store::clear()
+{
+    slots.clear();
+    free_slots.clear();
+    cells.clear();
+    live = 0;
+}
+
+mongroup &mongroup_store::insert( const mongroup &group )
+{
+    size_t index;
+    if( free_slots.empty() ) {
+        index = slots.size();
+        slots.emplace_back();
+    } else {
+        index = free_slots.back();
+        free_slots.pop_back();
+    }
+    slot &s = slots[index];
+    s.group = group;
+    s.indexed_pos = group.pos;
+    s.alive = true;
+    add_to_cell( index );
+    live++;
+    return s.group;
+}
+
+mongroup_store::iterator mongroup_store::erase( iterator it )
+{
+    slot &s = slots[it.index];
+    remove_from_cell( it.index );
+    s.alive = false;
+    // Don't keep the monsters of a dead group around until the slot is reused
+    s.group = mongroup();
+    free_slots.push_back( it.index );
+    live--;
+    ++it;
+    return it;
+}
+
+void mongroup_store::reindex( iterator it )
+{
+    slot &s = slots[it.index];
+    if( s.indexed_pos == s.group.pos ) {
+        return;
+    }
+    if( cell_of( s.indexed_pos ) != cell_of( s.group.pos ) ) {
+        remove_from_cell( it.index );
+        s.indexed_pos = s.group.pos;
+        add_to_cell( it.index );
+    } else {
+        s.indexed_pos = s.group.pos;
+    }
+}
+
+std::vector<mongroup *> mongroup_store::groups_at( const tripoint &p )
+{
+    std::vector<mongroup *> result;
+    const auto cell = cells.find( cell_of( p ) );
+    if( cell != cells.end() ) {
+        for( const size_t index : cell->second ) {
+            if( slots[index].indexed_pos == p ) {
+                result.push_back( &slots[index].group );
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<const mongroup *> mongroup_store::groups_at( const tripoint &p ) const
+{
+    std::vector<const mongroup *> result;
+    const auto cell = cells.find( cell_of( p ) );
+    if( cell != cells.end() ) {
+        for( const size_t index : cell->second ) {
+            if( slots[index].indexed_pos == p ) {
+                result.push_back( &slots[index].group );
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<mongroup *> mongroup_store::groups_in_radius( const tripoint &p, const int radius )
+{
+    std::vector<size_t> found;
+    const tripoint min_cell = cell_of( p - tripoint( radius, radius, 0 ) );
+    const tripoint max_cell = cell_of( p + tripoint( radius, radius, 0 ) );
+    const int min_z = std::max( -OVERMAP_DEPTH, p.z - radius );
+    const int max_z = std::min( OVERMAP_HEIGHT, p.z + radius );
+    for( int z = min_z; z <= max_z; z++ ) {
+        for( int x = min_cell.x; x <= max_cell.x; x++ ) {
+            for( int y = min_cell.y; y <= max_cell.y; y++ ) {
+                const auto cell = cells.find( tripoint( x, y, z ) );
+                if( cell == cells.end() ) {
+                    continue;
+                }
+                for( const size_t index : cell->second ) {
+                    if( rl_dist( p, slots[index].indexed_pos ) <= radius ) {
+                        found.push_back( index );
+                    }
+                }
+            }
+        }
+    }
+    // Slot order, so the result doesn't depend on how the groups moved between cells
+    std::sort( found.begin(), found.end() );
+    std::vector<mongroup *> result;
+    result.reserve( found.size() );
+    for( const size_t index : found ) {
+        result.push_back( &slots[index].group );
+    }
+    return result;
+}
+
 const MonsterGroup &MonsterGroupManager::GetUpgradedMonsterGroup( const mongroup_id &group )
 {
     const MonsterGroup *groupptr = &group.obj();
@@ -2,8 +2,12 @@
 #ifndef MONGROUP_H
 #define MONGROUP_H
 
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "calendar.h"
@@ -157,6 +161,122 @@ struct mongroup {
     void serialize( JsonOut &jsout ) const;
 };
 
+/**
+ * The monster groups of an overmap.
+ *
+ * Groups live in stable slots: pointers to a group stay valid while other groups are added,
+ * moved or removed, and a freed slot is reused by the next group added. A coarse spatial hash
+ * over the slots answers position and radius queries without looking at every group.
+ * Groups can be moved in place, the hash entry is updated by @ref reindex.
+ */
+class mongroup_store
+{
+    private:
+        struct slot {
+            mongroup group;
+            // Position the group is filed under in the hash, differs from group.pos
+            // after the group was moved until it is reindexed
+            tripoint indexed_pos;
+            bool alive = false;
+        };
+
+    public:
+        /** Iterates over the live groups in slot order. */
+        template<typename Store, typename Group>
+        class slot_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = mongroup;
+                using difference_type = std::ptrdiff_t;
+                using pointer = Group *;
+                using reference = Group &;
+
+                slot_iterator( Store *store, size_t index ) : store( store ), index( index ) {
+                    skip_dead();
+                }
+
+                reference operator*() const {
+                    return store->slots[index].group;
+                }
+                pointer operator->() const {
+                    return &store->slots[index].group;
+                }
+                slot_iterator &operator++() {
+                    ++index;
+                    skip_dead();
+                    return *this;
+                }
+                bool operator==( const slot_iterator &rhs ) const {
+                    return index == rhs.index;
+                }
+                bool operator!=( const slot_iterator &rhs ) const {
+                    return index != rhs.index;
+                }
+
+            private:
+                friend class mongroup_store;
+
+                void skip_dead() {
+                    while( index < store->slots.size() && !store->slots[index].alive ) {
+                        ++index;
+                    }
+                }
+
+                Store *store;
+                size_t index;
+        };
+        using iterator = slot_iterator<mongroup_store, mongroup>;
+        using const_iterator = slot_iterator<const mongroup_store, const mongroup>;
+
+        iterator begin() {
+            return iterator( this, 0 );
+        }
+        iterator end() {
+            return iterator( this, slots.size() );
+        }
+        const_iterator begin() const {
+            return const_iterator( this, 0 );
+        }
+        const_iterator end() const {
+            return const_iterator( this, slots.size() );
+        }
+
+        size_t size() const {
+            return live;
+        }
+        bool empty() const {
+            return live == 0;
+        }
+        void clear();
+
+        /** Adds a copy of the group, filed under its position. */
+        mongroup &insert( const mongroup &group );
+        /** Removes the group and returns an iterator to the next one. */
+        iterator erase( iterator it );
+        /** Files the group under its current position after it was moved. */
+        void reindex( iterator it );
+
+        /** Groups at exactly this position. */
+        std::vector<mongroup *> groups_at( const tripoint &p );
+        std::vector<const mongroup *> groups_at( const tripoint &p ) const;
+        /** Groups within @ref rl_dist radius of the position, on any z-level. */
+        std::vector<mongroup *> groups_in_radius( const tripoint &p, int radius );
+
+    private:
+        // Side length of a cell of the spatial hash, in submaps
+        static constexpr int cell_size = 12;
+        static tripoint cell_of( const tripoint &p );
+        void add_to_cell( size_t index );
+        void remove_from_cell( size_t index );
+
+        std::deque<slot> slots;
+        std::vector<size_t> free_slots;
+        // Slot indices of the groups in each cell of the spatial hash
+        std::unordered_map<tripoint, std::vector<size_t>> cells;
+        size_t live = 0;
+};
+
 class MonsterGroupManager
 {
     public:
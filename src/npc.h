@@ -6,6 +6,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "calendar.h"
@@ -324,6 +325,30 @@ struct npc_short_term_cache {
     std::map<direction, float> threat_map;
 };
 
+// What find_item has seen on the ground around the npc, see map::item_stamp.
+struct npc_scavenge_memory {
+    struct square {
+        uint64_t item_stamp;
+        // Value of the best item there the npc could carry, INT_MIN if there is none
+        int best_value;
+    };
+    // Keyed by absolute square
+    std::unordered_map<tripoint, square> squares;
+
+    // State of the npc the values were computed with, the memory is forgotten when it changes.
+    // Item values also depend on skills, rot and so on, which is covered by forgetting hourly.
+    int hunger = 0;
+    int thirst = 0;
+    itype_id weapon;
+    size_t inventory_size = 0;
+    units::volume volume_allowed = 0_ml;
+    units::mass weight_allowed = 0_gram;
+    time_point since = calendar::before_time_starts;
+
+    // Number of squares whose items were valued, whether remembered or not. Never reset.
+    int squares_valued = 0;
+};
+
 // DO NOT USE! This is old, use strings as talk topic instead, e.g. "TALK_AGREE_FOLLOW" instead of
 // TALK_AGREE_FOLLOW. There is also convert_talk_topic which can convert the enumeration values to
 // the new string values (used to load old saves).
@@ -903,7 +928,14 @@ class npc : public player
         std::map<std::string, time_point> complaints;
 
         npc_short_term_cache ai_cache;
+        npc_scavenge_memory scavenge_memory;
+        /** Forgets scavenge_memory if the values in it may be outdated. */
+        void refresh_scavenge_memory( const units::volume &volume_allowed,
+                                      const units::mass &weight_allowed );
     public:
+        const npc_scavenge_memory &get_scavenge_memory() const {
+            return scavenge_memory;
+        }
         /**
          * Global position, expressed in map square coordinate system
          * (the most detailed coordinate system), used by the @ref map.
@@ -1,6 +1,8 @@
 #include "npc.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
 #include <memory>
 #include <numeric>
 #include <sstream>
@@ -203,10 +205,15 @@ std::vector<sphere> npc::find_dangerous_explosives() const
 {
     std::vector<sphere> result;
 
-    const auto active_items = g->m.get_active_items_in_radius( pos(), MAX_VIEW_DISTANCE );
+    // The list of active items is shared by all NPCs on the level and only rebuilt when
+    // items come and go, instead of every NPC collecting the items around it each turn.
+    for( const auto &elem : g->m.get_active_items_on_level( posz() ) ) {
+        const tripoint &item_pos = elem.first;
+        if( rl_dist( pos(), item_pos ) > MAX_VIEW_DISTANCE ) {
+            continue;
+        }
 
-    for( const auto &elem : active_items ) {
-        const auto use = elem->type->get_use( "explosion" );
+        const auto use = elem.second->type->get_use( "explosion" );
 
         if( !use ) {
             continue;
@@ -215,17 +222,17 @@ std::vector<sphere> npc::find_dangerous_explosives() const
         const explosion_iuse *actor = dynamic_cast<const explosion_iuse *>( use->get_actor_ptr() );
         const int safe_range = actor->explosion.safe_range();
 
-        if( rl_dist( pos(), elem.position() ) >= safe_range ) {
+        if( rl_dist( pos(), item_pos ) >= safe_range ) {
             continue;   // Far enough.
         }
 
         const int turns_to_evacuate = 2 * safe_range / speed_rating();
 
-        if( elem->charges > turns_to_evacuate ) {
+        if( elem.second->charges > turns_to_evacuate ) {
             continue;   // Consider only imminent dangers.
         }
 
-        result.emplace_back( elem.position(), safe_range );
+        result.emplace_back( item_pos, safe_range );
     }
 
     return result;
@@ -288,17 +295,22 @@ void npc::assess_danger()
         cur_threat_map[ threat_dir ] = 0.25f * ai_cache.threat_map[ threat_dir ];
     }
     // first, check if we're about to be consumed by fire
-    for( const tripoint &pt : g->m.points_in_radius( pos(), 6 ) ) {
-        if( pt == pos() || g->m.has_flag( TFLAG_FIRE_CONTAINER,  pt ) ) {
+    // The fire positions are sorted by x, so only the columns within reach need to be checked
+    constexpr int fire_radius = 6;
+    const std::vector<point> &fires = g->m.get_fire_positions( posz() );
+    const point first_column( posx() - fire_radius, INT_MIN );
+    for( auto iter = std::lower_bound( fires.begin(), fires.end(), first_column );
+         iter != fires.end() && iter->x <= posx() + fire_radius; ++iter ) {
+        const tripoint pt( *iter, posz() );
+        if( std::abs( pt.y - posy() ) > fire_radius || pt == pos() ||
+            g->m.has_flag( TFLAG_FIRE_CONTAINER, pt ) ) {
             continue;
         }
-        if( g->m.get_field( pt, fd_fire ) != nullptr ) {
-            int dist = rl_dist( pos(), pt );
-            cur_threat_map[direction_from( pos(), pt )] += 2.0f * ( NPC_DANGER_MAX - dist );
-            if( dist < 3 && !has_effect( effect_npc_fire_bad ) ) {
-                warn_about( "fire_bad", 1_minutes );
-                add_effect( effect_npc_fire_bad, 5_turns );
-            }
+        int dist = rl_dist( pos(), pt );
+        cur_threat_map[direction_from( pos(), pt )] += 2.0f * ( NPC_DANGER_MAX - dist );
+        if( dist < 3 && !has_effect( effect_npc_fire_bad ) ) {
+            warn_about( "fire_bad", 1_minutes );
+            add_effect( effect_npc_fire_bad, 5_turns );
         }
     }
     for( const monster &critter : g->all_monsters() ) {
@@ -2062,28 +2074,33 @@ void npc::find_item()
         return;
     }
 
+    // Returns the value of the item, or INT_MIN if we don't want it at all.
     const auto consider_item =
         [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of_from_type( LIQUID ) ) {
             // Don't even consider liquids.
-            return;
+            return INT_MIN;
         }
 
         if( whitelisting && !item_whitelisted( it ) ) {
-            return;
+            return INT_MIN;
+        }
+
+        if( it.volume() > volume_allowed || it.weight() > weight_allowed ) {
+            return INT_MIN;
         }
 
         // When using a whitelist, skip the value check
         // TODO: Whitelist hierarchy?
         int itval = whitelisting ? 1000 : value( it );
 
-        if( itval > best_value &&
-            ( it.volume() <= volume_allowed && it.weight() <= weight_allowed ) ) {
+        if( itval > best_value ) {
             wanted_item_pos = p;
             wanted = &( it );
             best_value = itval;
         }
+        return itval;
     };
 
     // Harvest item doesn't exist, so we'll be checking by its name
@@ -2106,23 +2123,45 @@ void npc::find_item()
         }
     };
 
+    // Whitelisted items all have the same value, there is nothing worth remembering.
+    const bool remember = !whitelisting;
+    if( remember ) {
+        refresh_scavenge_memory( volume_allowed, weight_allowed );
+    }
+
     for( const tripoint &p : closest_tripoints_first( range, pos() ) ) {
+        const tripoint abs_p = g->m.getabs( p );
+        const uint64_t stamp = g->m.item_stamp( p );
+        const auto memo = scavenge_memory.squares.find( abs_p );
+        // Nothing was added or removed since we last found nothing good enough there.
+        const bool ground_known = remember && memo != scavenge_memory.squares.end() &&
+                                  memo->second.item_stamp == stamp &&
+                                  memo->second.best_value <= best_value;
+        const optional_vpart_position vp = g->m.veh_at( p );
+        if( ground_known && !vp ) {
+            continue;
+        }
+
         // TODO: Make this sight check not overdraw nearby tiles
         // TODO: Optimize that zone check
         if( is_following() && g->check_zone( no_pickup, p ) ) {
             continue;
         }
 
-        if( g->m.sees_some_items( p, *this ) && sees( p ) ) {
+        if( !ground_known && g->m.sees_some_items( p, *this ) && sees( p ) ) {
+            scavenge_memory.squares_valued++;
+            int square_best = INT_MIN;
             for( const item &it : g->m.i_at( p ) ) {
-                consider_item( it, p );
+                square_best = std::max( square_best, consider_item( it, p ) );
+            }
+            if( remember ) {
+                scavenge_memory.squares[abs_p] = npc_scavenge_memory::square{ stamp, square_best };
             }
         }
 
         // Allow terrain check without sight, because it would cost more CPU than it is worth
         consider_terrain( p );
 
-        const optional_vpart_position vp = g->m.veh_at( p );
         if( !vp || vp->vehicle().is_moving() || !sees( p ) ) {
             continue;
         }
@@ -2170,6 +2209,28 @@ void npc::find_item()
     }
 }
 
+void npc::refresh_scavenge_memory( const units::volume &volume_allowed,
+                                   const units::mass &weight_allowed )
+{
+    npc_scavenge_memory &mem = scavenge_memory;
+    // Range of find_item is small, so this only fills up when travelling.
+    const size_t max_squares = 4096;
+    if( mem.hunger == get_hunger() && mem.thirst == get_thirst() &&
+        mem.weapon == weapon.typeId() && mem.inventory_size == inv.size() &&
+        mem.volume_allowed == volume_allowed && mem.weight_allowed == weight_allowed &&
+        calendar::turn - mem.since < 1_hours && mem.squares.size() < max_squares ) {
+        return;
+    }
+    mem.squares.clear();
+    mem.hunger = get_hunger();
+    mem.thirst = get_thirst();
+    mem.weapon = weapon.typeId();
+    mem.inventory_size = inv.size();
+    mem.volume_allowed = volume_allowed;
+    mem.weight_allowed = weight_allowed;
+    mem.since = calendar::turn;
+}
+
 void npc::pick_up_item()
 {
     if( is_following() && !rules.has_flag( ally_rule::allow_pick_up ) ) {
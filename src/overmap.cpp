@@ -11,6 +11,7 @@
 #include <ostream>
 #include <queue>
 #include <random>
+#include <unordered_map>
 #include <vector>
 
 #include "catacharset.h"
@@ -1084,9 +1085,13 @@ void overmap::init_layers()
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
         const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
 
+        std::array<oter_id, OMAPY> column;
+        column.fill( tid );
+        layer[k].terrain.assign( OMAPX, column );
+        layer[k].terrain_runs.clear();
+        layer[k].terrain_tiles.clear();
         for( int i = 0; i < OMAPX; ++i ) {
             for( int j = 0; j < OMAPY; ++j ) {
-                layer[k].terrain[i][j] = tid;
                 layer[k].visible[i][j] = false;
                 layer[k].explored[i][j] = false;
             }
@@ -1094,13 +1099,91 @@ void overmap::init_layers()
     }
 }
 
+// Runs number the tiles row by row, the order layers are saved in.
+static oter_id packed_ter( const map_layer &l, const int x, const int y )
+{
+    const int index = y * OMAPX + x;
+    const auto run = std::upper_bound( l.terrain_runs.begin(), l.terrain_runs.end(), index,
+    []( const int i, const std::pair<int, oter_id> &r ) {
+        return i < r.first;
+    } );
+    return run != l.terrain_runs.end() ? run->second : ot_null;
+}
+
+static void unpack_terrain( map_layer &l )
+{
+    l.terrain.resize( OMAPX );
+    int index = 0;
+    for( const auto &run : l.terrain_runs ) {
+        for( ; index < run.first; index++ ) {
+            l.terrain[index % OMAPX][index / OMAPX] = run.second;
+        }
+    }
+    std::vector<std::pair<int, oter_id>>().swap( l.terrain_runs );
+}
+
+static void drop_terrain_index( map_layer &l )
+{
+    std::vector<std::pair<oter_id, std::vector<int>>>().swap( l.terrain_tiles );
+    std::vector<bool>().swap( l.tile_changed );
+    std::vector<int>().swap( l.changed_tiles );
+}
+
+static void note_terrain_change( map_layer &l, const int index )
+{
+    if( l.tile_changed[index] ) {
+        return;
+    }
+    l.tile_changed[index] = true;
+    l.changed_tiles.push_back( index );
+    // Past this many the index saves too little, it is built again by the next search
+    if( l.changed_tiles.size() > OMAPX * OMAPY / 4 ) {
+        drop_terrain_index( l );
+    }
+}
+
+static void build_terrain_index( map_layer &l )
+{
+    std::unordered_map<oter_id, size_t> slot_of;
+    const auto add = [&l, &slot_of]( const oter_id & ot, const int first, const int last ) {
+        const auto slot = slot_of.emplace( ot, l.terrain_tiles.size() );
+        if( slot.second ) {
+            l.terrain_tiles.emplace_back( ot, std::vector<int>() );
+        }
+        std::vector<int> &tiles = l.terrain_tiles[slot.first->second].second;
+        for( int index = first; index < last; index++ ) {
+            tiles.push_back( index );
+        }
+    };
+    if( l.terrain.empty() ) {
+        int start = 0;
+        for( const auto &run : l.terrain_runs ) {
+            add( run.second, start, run.first );
+            start = run.first;
+        }
+    } else {
+        for( int index = 0; index < OMAPX * OMAPY; index++ ) {
+            add( l.terrain[index % OMAPX][index / OMAPX], index, index + 1 );
+        }
+    }
+    l.tile_changed.assign( OMAPX * OMAPY, false );
+    l.changed_tiles.clear();
+}
+
 oter_id &overmap::ter( const int x, const int y, const int z )
 {
     if( !inbounds( tripoint( x, y, z ) ) ) {
         return ot_null;
     }
 
-    return layer[z + OVERMAP_DEPTH].terrain[x][y];
+    map_layer &l = layer[z + OVERMAP_DEPTH];
+    if( l.terrain.empty() ) {
+        unpack_terrain( l );
+    }
+    if( !l.terrain_tiles.empty() ) {
+        note_terrain_change( l, y * OMAPX + x );
+    }
+    return l.terrain[x][y];
 }
 
 oter_id &overmap::ter( const tripoint &p )
@@ -1114,7 +1197,11 @@ const oter_id overmap::get_ter( const int x, const int y, const int z ) const
         return ot_null;
     }
 
-    return layer[z + OVERMAP_DEPTH].terrain[x][y];
+    const map_layer &l = layer[z + OVERMAP_DEPTH];
+    if( l.terrain.empty() ) {
+        return packed_ter( l, x, y );
+    }
+    return l.terrain[x][y];
 }
 
 const oter_id overmap::get_ter( const tripoint &p ) const
@@ -1150,19 +1237,19 @@ bool overmap::is_explored( const int x, const int y, const int z ) const
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
 {
-    const auto matching_range = zg.equal_range( candidate.pos );
-    return std::find_if( matching_range.first, matching_range.second,
-    [candidate]( std::pair<tripoint, mongroup> match ) {
+    const std::vector<const mongroup *> matching = zg.groups_at( candidate.pos );
+    return std::find_if( matching.begin(), matching.end(),
+    [&candidate]( const mongroup * match ) {
         // This is extra strict since we're using it to test serialization.
-        return candidate.type == match.second.type && candidate.pos == match.second.pos &&
-               candidate.radius == match.second.radius &&
-               candidate.population == match.second.population &&
-               candidate.target == match.second.target &&
-               candidate.interest == match.second.interest &&
-               candidate.dying == match.second.dying &&
-               candidate.horde == match.second.horde &&
-               candidate.diffuse == match.second.diffuse;
-    } ) != matching_range.second;
+        return candidate.type == match->type && candidate.pos == match->pos &&
+               candidate.radius == match->radius &&
+               candidate.population == match->population &&
+               candidate.target == match->target &&
+               candidate.interest == match->interest &&
+               candidate.dying == match->dying &&
+               candidate.horde == match->horde &&
+               candidate.diffuse == match->diffuse;
+    } ) != matching.end();
 }
 
 bool overmap::monster_check( const std::pair<tripoint, monster> &candidate ) const
@@ -1263,6 +1350,33 @@ void overmap::delete_note( const int x, const int y, const int z )
     add_note( x, y, z, std::string {} );
 }
 
+void overmap::find_terrain( const int z, const std::function<bool( const oter_id & )> &matches,
+                            std::vector<tripoint> &found )
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    map_layer &l = layer[z + OVERMAP_DEPTH];
+    if( l.terrain_tiles.empty() ) {
+        build_terrain_index( l );
+    }
+    for( const auto &tiles : l.terrain_tiles ) {
+        if( !matches( tiles.first ) ) {
+            continue;
+        }
+        for( const int index : tiles.second ) {
+            if( !l.tile_changed[index] ) {
+                found.emplace_back( index % OMAPX, index / OMAPX, z );
+            }
+        }
+    }
+    for( const int index : l.changed_tiles ) {
+        if( matches( get_ter( index % OMAPX, index / OMAPX, z ) ) ) {
+            found.emplace_back( index % OMAPX, index / OMAPX, z );
+        }
+    }
+}
+
 std::vector<point> overmap::find_notes( const int z, const std::string &text )
 {
     std::vector<point> note_locations;
@@ -1822,13 +1936,13 @@ tripoint overmap::find_random_omt( const std::string &omt_base_type ) const
 void overmap::process_mongroups()
 {
     for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+        mongroup &mg = *it;
         if( mg.dying ) {
             mg.population = ( mg.population * 4 ) / 5;
             mg.radius = ( mg.radius * 9 ) / 10;
         }
         if( mg.empty() ) {
-            zg.erase( it++ );
+            it = zg.erase( it );
         } else {
             ++it;
         }
@@ -1873,13 +1987,11 @@ void mongroup::wander( const overmap &om )
 
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
     //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    // Groups are moved in place, every group is visited exactly once.
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        mongroup &mg = *it;
         if( !mg.horde ) {
-            ++it;
             continue;
         }
 
@@ -1928,15 +2040,10 @@ void overmap::move_hordes()
                 mg.pos.y++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
+            // File the group under its new location
+            zg.reindex( it );
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
         static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
@@ -1971,19 +2078,15 @@ void overmap::move_hordes()
 
             // Scan for compatible hordes in this area, selecting the largest.
             mongroup *add_to_group = nullptr;
-            auto group_bucket = zg.equal_range( p );
             std::vector<monster>::size_type add_to_horde_size = 0;
-            std::for_each( group_bucket.first, group_bucket.second,
-            [&]( std::pair<const tripoint, mongroup> &horde_entry ) {
-                mongroup &horde = horde_entry.second;
-
+            for( mongroup *horde : zg.groups_at( p ) ) {
                 // We only absorb zombies into GROUP_ZOMBIE hordes
-                if( horde.horde && !horde.monsters.empty() && horde.type == GROUP_ZOMBIE &&
-                    horde.monsters.size() > add_to_horde_size ) {
-                    add_to_group = &horde;
-                    add_to_horde_size = horde.monsters.size();
+                if( horde->horde && !horde->monsters.empty() && horde->type == GROUP_ZOMBIE &&
+                    horde->monsters.size() > add_to_horde_size ) {
+                    add_to_group = horde;
+                    add_to_horde_size = horde->monsters.size();
                 }
-            } );
+            }
 
             // Check again if the zombie will join the largest horde, now that we know the accurate size.
             if( this_monster.will_join_horde( add_to_horde_size ) ) {
@@ -2015,15 +2118,13 @@ void overmap::move_hordes()
 */
 void overmap::signal_hordes( const tripoint &p, const int sig_power )
 {
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    // Only the groups within reach of the signal are looked at
+    for( mongroup *group : zg.groups_in_radius( p, sig_power ) ) {
+        mongroup &mg = *group;
         if( !mg.horde ) {
             continue;
         }
         const int dist = rl_dist( p, mg.pos );
-        if( sig_power < dist ) {
-            continue;
-        }
         // TODO: base this in monster attributes, foremost GOODHEARING.
         const int inter_per_sig_power = 15; //Interest per signal value
         const int min_initial_inter = 30; //Min initial interest for horde
@@ -3987,7 +4088,7 @@ void overmap::add_mon_group( const mongroup &group )
     // makes the diffuse setting obsolete (as it only controls how the radius
     // is interpreted) - it's only used when adding monster groups with function.
     if( group.radius == 1 ) {
-        zg.insert( std::pair<tripoint, mongroup>( group.pos, group ) );
+        zg.insert( group );
         return;
     }
     // diffuse groups use a circular area, non-diffuse groups use a rectangular area
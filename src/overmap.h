@@ -10,10 +10,12 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "basecamp.h"
 #include "game_constants.h"
+#include "mongroup.h"
 #include "monster.h"
 #include "omdata.h"
 #include "overmap_types.h" // IWYU pragma: keep
@@ -30,7 +32,6 @@ namespace catacurses
 {
 class window;
 } // namespace catacurses
-struct mongroup;
 
 namespace pf
 {
@@ -90,7 +91,22 @@ struct radio_tower {
 };
 
 struct map_layer {
-    oter_id terrain[OMAPX][OMAPY];
+    /** Indexed [x][y], empty while the layer is only held as @ref terrain_runs. */
+    std::vector<std::array<oter_id, OMAPY>> terrain;
+    /**
+     * Terrain of a layer read from a save, as it was saved: runs of tiles row by row,
+     * each the index one past its last tile and its terrain. Tiles are looked up in the
+     * runs until something asks to change the layer, which unpacks it into @ref terrain.
+     */
+    std::vector<std::pair<int, oter_id>> terrain_runs;
+    /**
+     * The tiles of each terrain on the layer, as sorted indices row by row, built by the
+     * first search of the layer. Tiles handed out by overmap::ter since then could have
+     * changed, they are listed in @ref changed_tiles and looked at directly instead.
+     */
+    std::vector<std::pair<oter_id, std::vector<int>>> terrain_tiles;
+    std::vector<bool> tile_changed;
+    std::vector<int> changed_tiles;
     bool visible[OMAPX][OMAPY];
     bool explored[OMAPX][OMAPY];
     std::vector<om_note> notes;
@@ -224,6 +240,13 @@ class overmap
          */
         std::vector<point> find_notes( const int z, const std::string &text );
 
+        /**
+         * Appends the (local) coordinates of every tile on level z whose terrain
+         * satisfies @p matches to @p found. Each terrain type is tested once, not each tile.
+         */
+        void find_terrain( int z, const std::function<bool( const oter_id & )> &matches,
+                           std::vector<tripoint> &found );
+
         /**
          * Returns whether or not the location has been generated (e.g. mapgen has run).
          * @param loc Location to check.
@@ -241,7 +264,7 @@ class overmap
 
         void clear_mon_groups();
     private:
-        std::multimap<tripoint, mongroup> zg;
+        mongroup_store zg;
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
@@ -275,6 +298,10 @@ class overmap
 
         std::vector<std::shared_ptr<npc>> npcs;
 
+        // Set whenever the buffer hands the overmap out to be read or changed, cleared once
+        // it has been saved. Overmaps nobody asked for since are not written again.
+        bool unsaved = true;
+
         bool nullbool = false;
         point loc = point_zero;
 
@@ -1101,31 +1101,32 @@ tripoint display( const tripoint &orig, const draw_data_t &data = draw_data_t()
             }
 
             std::vector<point> locations;
-            std::vector<point> overmap_checked;
-
-            for( int x = curs.x - OMAPX / 2; x < curs.x + OMAPX / 2; x++ ) {
-                for( int y = curs.y - OMAPY / 2; y < curs.y + OMAPY / 2; y++ ) {
-                    overmap *om = overmap_buffer.get_existing_om_global( point( x, y ) );
-
-                    if( om ) {
-                        int om_relative_x = x;
-                        int om_relative_y = y;
-                        omt_to_om_remain( om_relative_x, om_relative_y );
-
-                        int om_cache_x = x;
-                        int om_cache_y = y;
-                        omt_to_om( om_cache_x, om_cache_y );
-
-                        if( std::find( overmap_checked.begin(), overmap_checked.end(), point( om_cache_x,
-                                       om_cache_y ) ) == overmap_checked.end() ) {
-                            overmap_checked.push_back( point( om_cache_x, om_cache_y ) );
-                            std::vector<point> notes = om->find_notes( curs.z, term );
-                            locations.insert( locations.end(), notes.begin(), notes.end() );
-                        }
-
-                        if( om->seen( om_relative_x, om_relative_y, curs.z ) &&
-                            match_include_exclude( om->ter( om_relative_x, om_relative_y, curs.z )->get_name(), term ) ) {
-                            locations.push_back( om->global_base_point() + point( om_relative_x, om_relative_y ) );
+            const point area_min( curs.x - OMAPX / 2, curs.y - OMAPY / 2 );
+            const point area_max( curs.x + OMAPX / 2, curs.y + OMAPY / 2 );
+            const point om_min = omt_to_om_copy( area_min );
+            const point om_max = omt_to_om_copy( area_max.x - 1, area_max.y - 1 );
+            const auto matches = [&term]( const oter_id & ot ) {
+                return match_include_exclude( ot->get_name(), term );
+            };
+            std::vector<tripoint> found;
+            for( int omx = om_min.x; omx <= om_max.x; omx++ ) {
+                for( int omy = om_min.y; omy <= om_max.y; omy++ ) {
+                    overmap *om = overmap_buffer.get_existing( omx, omy );
+                    if( om == nullptr ) {
+                        continue;
+                    }
+                    std::vector<point> notes = om->find_notes( curs.z, term );
+                    locations.insert( locations.end(), notes.begin(), notes.end() );
+
+                    // Only the kinds of terrain named by the term are looked at
+                    found.clear();
+                    om->find_terrain( curs.z, matches, found );
+                    const point base = om->global_base_point();
+                    for( const tripoint &p : found ) {
+                        const point loc = base + point( p.x, p.y );
+                        if( loc.x >= area_min.x && loc.x < area_max.x && loc.y >= area_min.y &&
+                            loc.y < area_max.y && om->seen( p.x, p.y, curs.z ) ) {
+                            locations.push_back( loc );
                         }
                     }
                 }
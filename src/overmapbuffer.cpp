@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <functional>
 #include <sstream>
+#include <tuple>
 
 #include "basecamp.h"
 #include "cata_utility.h"
@@ -69,11 +71,13 @@ overmap &overmapbuffer::get( const int x, const int y )
     const point p { x, y };
 
     if( last_requested_overmap != nullptr && last_requested_overmap->pos() == p ) {
+        last_requested_overmap->unsaved = true;
         return *last_requested_overmap;
     }
 
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
+        it->second->unsaved = true;
         return *( last_requested_overmap = it->second.get() );
     }
 
@@ -107,11 +111,11 @@ void overmapbuffer::create_custom_overmap( const int x, const int y,
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
-        auto &mg = it->second;
+        auto &mg = *it;
         // spawn related code simply sets population to 0 when they have been
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
-            new_overmap.zg.erase( it++ );
+            it = new_overmap.zg.erase( it );
             continue;
         }
         // Inside the bounds of the overmap?
@@ -132,7 +136,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         mg.pos.x = smabs.x;
         mg.pos.y = smabs.y;
         om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
+        it = new_overmap.zg.erase( it );
     }
 }
 
@@ -189,8 +193,15 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
 void overmapbuffer::save()
 {
     for( auto &omp : overmaps ) {
+        overmap &om = *omp.second;
+        // NPCs and camps are changed through pointers the buffer does not see,
+        // so overmaps holding any are always written.
+        if( !om.unsaved && om.npcs.empty() && om.camps.empty() ) {
+            continue;
+        }
         // Note: this may throw io errors from std::ofstream
-        omp.second->save();
+        om.save();
+        om.unsaved = false;
     }
 }
 
@@ -199,6 +210,7 @@ void overmapbuffer::clear()
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
+    npc_paths.clear();
 }
 
 const regional_settings &overmapbuffer::get_settings( int x, int y, int z )
@@ -227,10 +239,12 @@ overmap *overmapbuffer::get_existing( int x, int y )
     const point p {x, y};
 
     if( last_requested_overmap && last_requested_overmap->pos() == p ) {
+        last_requested_overmap->unsaved = true;
         return last_requested_overmap;
     }
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
+        it->second->unsaved = true;
         return last_requested_overmap = it->second.get();
     }
     if( known_non_existing.count( p ) > 0 ) {
@@ -505,12 +519,11 @@ std::vector<mongroup *> overmapbuffer::groups_at( int x, int y, int z )
     }
     const tripoint dpos( x, y, z );
     overmap &om = get( omp.x, omp.y );
-    for( auto it = om.zg.lower_bound( dpos ), end = om.zg.upper_bound( dpos ); it != end; ++it ) {
-        auto &mg = it->second;
-        if( mg.empty() ) {
+    for( mongroup *mg : om.zg.groups_at( dpos ) ) {
+        if( mg->empty() ) {
             continue;
         }
-        result.push_back( &mg );
+        result.push_back( mg );
     }
     return result;
 }
@@ -669,15 +682,56 @@ bool overmapbuffer::reveal( const tripoint &center, int radius,
     return result;
 }
 
+// Cost for an npc to travel through the overmap terrain, pf::rejected if it can't.
+static int npc_travel_cost( const oter_id &oter )
+{
+    if( oter->get_name() == "solid rock" || oter->get_name() == "open air" ) {
+        return pf::rejected;
+    } else if( oter->get_name() == "forest" ) {
+        return 10;
+    } else if( oter->get_name() == "swamp" ) {
+        return 15;
+    } else if( oter->get_name() == "road" ) {
+        return 1;
+    } else if( oter->get_name() == "river" ) {
+        return 20;
+    }
+    return static_cast<int>( oter->get_travel_cost() );
+}
+
 std::vector<tripoint> overmapbuffer::get_npc_path( const tripoint &src, const tripoint &dest )
 {
     std::vector<tripoint> path;
     static const int RADIUS = 4;            // Maximal radius of search (in overmaps)
     static const int OX = RADIUS * OMAPX;   // half-width of the area to search in
     static const int OY = RADIUS * OMAPY;   // half-height of the area to search in
+    // Bounds of the path cache, which is dropped as a whole when it has too many destinations.
+    static const size_t max_destinations = 256;
+    static const size_t max_paths_per_destination = 8;
     if( src == overmap::invalid_tripoint || dest == overmap::invalid_tripoint ) {
         return path;
     }
+
+    if( npc_paths.size() >= max_destinations && npc_paths.count( dest ) == 0 ) {
+        npc_paths.clear();
+    }
+    std::vector<std::vector<tripoint>> &known_paths = npc_paths[dest];
+    for( const std::vector<tripoint> &known : known_paths ) {
+        const auto here = std::find( known.begin(), known.end(), src );
+        if( here == known.end() ) {
+            continue;
+        }
+        // Terrain may have changed since, the rest of the path must still be passable.
+        const bool passable = std::none_of( known.begin(), here, [this]( const tripoint & p ) {
+            return npc_travel_cost( ter( p ) ) == pf::rejected;
+        } );
+        if( passable ) {
+            npc_path_stats.hits++;
+            return std::vector<tripoint>( known.begin(), std::next( here ) );
+        }
+    }
+    npc_path_stats.misses++;
+
     const tripoint start( OX, OY, src.z );   // Local source - center of the local area
     const tripoint base( src - start );      // To convert local coordinates to global ones
     const tripoint finish( dest - base );       // Local destination - relative to source
@@ -689,18 +743,9 @@ std::vector<tripoint> overmapbuffer::get_npc_path( const tripoint &src, const tr
     };
     const auto estimate = [&]( const pf::node & cur, const pf::node * ) {
         int res = 0;
-        const auto oter = get_ter_at( cur.x, cur.y );
-        int travel_cost = static_cast<int>( oter->get_travel_cost() );
-        if( oter->get_name() == "solid rock" || oter->get_name() == "open air" ) {
+        const int travel_cost = npc_travel_cost( get_ter_at( cur.x, cur.y ) );
+        if( travel_cost == pf::rejected ) {
             return pf::rejected;
-        } else if( oter->get_name() == "forest" ) {
-            travel_cost = 10;
-        } else if( oter->get_name() == "swamp" ) {
-            travel_cost = 15;
-        } else if( oter->get_name() == "road" ) {
-            travel_cost = 1;
-        } else if( oter->get_name() == "river" ) {
-            travel_cost = 20;
         }
         res += travel_cost;
         res += std::abs( finish.x - cur.x ) +
@@ -714,9 +759,22 @@ std::vector<tripoint> overmapbuffer::get_npc_path( const tripoint &src, const tr
         tripoint convert_result = base + tripoint( node.x, node.y, base.z );
         path.push_back( convert_result );
     }
+    if( !path.empty() ) {
+        if( known_paths.size() >= max_paths_per_destination ) {
+            known_paths.erase( known_paths.begin() );
+        }
+        known_paths.push_back( path );
+    }
     return path;
 }
 
+npc_path_cache_stats overmapbuffer::take_npc_path_stats()
+{
+    const npc_path_cache_stats result = npc_path_stats;
+    npc_path_stats = npc_path_cache_stats();
+    return result;
+}
+
 bool overmapbuffer::reveal_route( const tripoint &source, const tripoint &dest, int radius,
                                   bool road_only )
 {
@@ -874,6 +932,77 @@ bool overmapbuffer::is_findable_location( const tripoint &location, const std::s
     return true;
 }
 
+static std::function<bool( const oter_id & )> terrain_matcher( const std::string &type,
+        const bool allow_subtype_matches )
+{
+    if( allow_subtype_matches ) {
+        return [type]( const oter_id & ot ) {
+            return is_ot_subtype( type.c_str(), ot );
+        };
+    }
+    return [type]( const oter_id & ot ) {
+        return is_ot_type( type, ot );
+    };
+}
+
+// When find_closest's expanding box reaches a tile: the distance, the step along that ring of
+// the box, the z-level and the edge (north, south, west, east), compared in that order.
+using box_scan_position = std::tuple<int, int, int, int>;
+
+static box_scan_position closest_scan_position( const tripoint &origin, const tripoint &p )
+{
+    const int dx = p.x - origin.x;
+    const int dy = p.y - origin.y;
+    const int dist = std::max( std::abs( dx ), std::abs( dy ) );
+    if( dy == -dist && dx < dist ) {
+        return box_scan_position( dist, dx + dist, p.z, 0 );
+    } else if( dy == dist && dx > -dist ) {
+        return box_scan_position( dist, dist - dx, p.z, 1 );
+    } else if( dx == -dist ) {
+        return box_scan_position( dist, dist - dy, p.z, 2 );
+    }
+    return box_scan_position( dist, dy + dist, p.z, 3 );
+}
+
+// When the expanding box first reaches a tile of the overmap at om_pos, which is when
+// the box scan would have loaded or generated it.
+static box_scan_position first_scan_position( const tripoint &origin, const point &om_pos )
+{
+    const point min( om_pos.x * OMAPX, om_pos.y * OMAPY );
+    const point max = min + point( OMAPX - 1, OMAPY - 1 );
+    const int dist = std::max( { min.x - origin.x, origin.x - max.x, min.y - origin.y,
+                                 origin.y - max.y, 0
+                               } );
+    if( dist == 0 ) {
+        // Holds the origin, which is looked at first
+        return box_scan_position( 0, 0, -OVERMAP_DEPTH, 0 );
+    }
+    // The overmap's tiles on the ring form a segment of each edge of the ring they meet,
+    // the steps along a segment only go up or down, so one of its ends is first.
+    const int left = origin.x - dist;
+    const int right = origin.x + dist;
+    const int top = origin.y - dist;
+    const int bottom = origin.y + dist;
+    std::vector<tripoint> ends;
+    for( const int y : { top, bottom } ) {
+        if( y >= min.y && y <= max.y ) {
+            ends.emplace_back( std::max( min.x, left ), y, -OVERMAP_DEPTH );
+            ends.emplace_back( std::min( max.x, right ), y, -OVERMAP_DEPTH );
+        }
+    }
+    for( const int x : { left, right } ) {
+        if( x >= min.x && x <= max.x ) {
+            ends.emplace_back( x, std::max( min.y, top ), -OVERMAP_DEPTH );
+            ends.emplace_back( x, std::min( max.y, bottom ), -OVERMAP_DEPTH );
+        }
+    }
+    box_scan_position first = closest_scan_position( origin, ends.front() );
+    for( const tripoint &p : ends ) {
+        first = std::min( first, closest_scan_position( origin, p ) );
+    }
+    return first;
+}
+
 tripoint overmapbuffer::find_closest( const tripoint &origin, const std::string &type,
                                       int const radius, bool must_be_seen, bool allow_subtype_matches,
                                       bool existing_overmaps_only,
@@ -902,43 +1031,55 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const std::string
     // and each additional one expends the search to the next concentric circle of overmaps.
 
     int max = ( radius == 0 ? OMAPX * 5 : radius );
-    // expanding box
-    for( int dist = 0; dist <= max; dist++ ) {
-        // each edge length is 2*dist-2, because corners belong to one edge
-        // south is +y, north is -y
-        for( int i = 0; i < dist * 2; i++ ) {
-            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-                //start at northwest, scan north edge
-                const tripoint n_loc( origin.x - dist + i, origin.y - dist, z );
-                if( is_findable_location( n_loc, type, must_be_seen, allow_subtype_matches, existing_overmaps_only,
-                                          om_special ) ) {
-                    return n_loc;
-                }
 
-                //start at southeast, scan south
-                const tripoint s_loc( origin.x + dist - i, origin.y + dist, z );
-                if( is_findable_location( s_loc, type, must_be_seen, allow_subtype_matches, existing_overmaps_only,
-                                          om_special ) ) {
-                    return s_loc;
-                }
+    // The result is the one an expanding box around the origin, scanning every z-level of each
+    // ring, would find first. Only the matching tiles of each overmap are looked at, and the
+    // overmaps are taken in the order that box reaches them, so the same ones are generated.
+    std::vector<std::pair<box_scan_position, point>> reached;
+    const point om_min = omt_to_om_copy( origin.x - max, origin.y - max );
+    const point om_max = omt_to_om_copy( origin.x + max, origin.y + max );
+    for( int omx = om_min.x; omx <= om_max.x; omx++ ) {
+        for( int omy = om_min.y; omy <= om_max.y; omy++ ) {
+            const point om_pos( omx, omy );
+            reached.emplace_back( first_scan_position( origin, om_pos ), om_pos );
+        }
+    }
+    std::sort( reached.begin(), reached.end() );
 
-                //start at southwest, scan west
-                const tripoint w_loc( origin.x - dist, origin.y + dist - i, z );
-                if( is_findable_location( w_loc, type, must_be_seen, allow_subtype_matches, existing_overmaps_only,
-                                          om_special ) ) {
-                    return w_loc;
+    const auto matches = terrain_matcher( type, allow_subtype_matches );
+    cata::optional<box_scan_position> best;
+    tripoint best_loc = overmap::invalid_tripoint;
+    std::vector<tripoint> found;
+    for( const auto &om_reached : reached ) {
+        if( best && *best < om_reached.first ) {
+            break;
+        }
+        const point &om_pos = om_reached.second;
+        overmap *om = existing_overmaps_only ? get_existing( om_pos.x, om_pos.y ) : &get( om_pos.x,
+                      om_pos.y );
+        if( om == nullptr ) {
+            continue;
+        }
+        const point base = om->global_base_point();
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            found.clear();
+            om->find_terrain( z, matches, found );
+            for( const tripoint &p : found ) {
+                const tripoint loc( base.x + p.x, base.y + p.y, z );
+                const box_scan_position pos = closest_scan_position( origin, loc );
+                const int dist = std::get<0>( pos );
+                if( dist == 0 || dist > max || ( best && *best < pos ) ) {
+                    continue;
                 }
-
-                //start at northeast, scan east
-                const tripoint e_loc( origin.x + dist, origin.y - dist + i, z );
-                if( is_findable_location( e_loc, type, must_be_seen, allow_subtype_matches, existing_overmaps_only,
-                                          om_special ) ) {
-                    return e_loc;
+                if( is_findable_location( loc, type, must_be_seen, allow_subtype_matches,
+                                          existing_overmaps_only, om_special ) ) {
+                    best = pos;
+                    best_loc = loc;
                 }
             }
         }
     }
-    return overmap::invalid_tripoint;
+    return best_loc;
 }
 
 std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin, const std::string &type,
@@ -949,15 +1090,35 @@ std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin, const std
     std::vector<tripoint> result;
     // dist == 0 means search a whole overmap diameter.
     dist = dist ? dist : OMAPX;
-    for( int x = origin.x - dist; x <= origin.x + dist; x++ ) {
-        for( int y = origin.y - dist; y <= origin.y + dist; y++ ) {
-            const tripoint search_loc( x, y, origin.z );
-            if( is_findable_location( search_loc, type, must_be_seen, allow_subtype_matches,
-                                      existing_overmaps_only, om_special ) ) {
-                result.push_back( search_loc );
+    const auto matches = terrain_matcher( type, allow_subtype_matches );
+    // Overmaps are taken column by column, like a scan of the area would reach them.
+    const point om_min = omt_to_om_copy( origin.x - dist, origin.y - dist );
+    const point om_max = omt_to_om_copy( origin.x + dist, origin.y + dist );
+    std::vector<tripoint> found;
+    for( int omx = om_min.x; omx <= om_max.x; omx++ ) {
+        for( int omy = om_min.y; omy <= om_max.y; omy++ ) {
+            overmap *om = existing_overmaps_only ? get_existing( omx, omy ) : &get( omx, omy );
+            if( om == nullptr ) {
+                continue;
+            }
+            found.clear();
+            om->find_terrain( origin.z, matches, found );
+            const point base = om->global_base_point();
+            for( const tripoint &p : found ) {
+                const tripoint search_loc( base.x + p.x, base.y + p.y, origin.z );
+                if( std::abs( search_loc.x - origin.x ) <= dist &&
+                    std::abs( search_loc.y - origin.y ) <= dist &&
+                    is_findable_location( search_loc, type, must_be_seen, allow_subtype_matches,
+                                          existing_overmaps_only, om_special ) ) {
+                    result.push_back( search_loc );
+                }
             }
         }
     }
+    // In the order of a scan of the area, column by column
+    std::sort( result.begin(), result.end(), []( const tripoint & lhs, const tripoint & rhs ) {
+        return lhs.x != rhs.x ? lhs.x < rhs.x : lhs.y < rhs.y;
+    } );
     return result;
 }
 
@@ -1006,6 +1167,7 @@ std::shared_ptr<npc> overmapbuffer::remove_npc( const int id )
 {
     for( auto &it : overmaps ) {
         if( const auto p = it.second->erase_npc( id ) ) {
+            it.second->unsaved = true;
             return p;
         }
     }
@@ -2,6 +2,7 @@
 #ifndef OVERMAPBUFFER_H
 #define OVERMAPBUFFER_H
 
+#include <map>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -70,6 +71,12 @@ struct camp_reference {
     int get_distance_from_bounds() const;
 };
 
+/** How often overmapbuffer::get_npc_path could reuse a path it had found before. */
+struct npc_path_cache_stats {
+    int hits = 0;
+    int misses = 0;
+};
+
 struct overmap_with_local_coordinates {
     overmap *overmap_pointer;
     tripoint coordinates;
@@ -88,6 +95,7 @@ class overmapbuffer
          * compared with the position of the overmap.
          */
         overmap &get( const int x, const int y );
+        /** Writes the overmaps that may have changed since they were last saved. */
         void save();
         void clear();
         void create_custom_overmap( const int x, const int y, overmap_special_batch &specials );
@@ -297,7 +305,14 @@ class overmapbuffer
         bool reveal( const tripoint &center, int radius );
         bool reveal( const tripoint &center, int radius,
                      const std::function<bool( const oter_id & )> &filter );
+        /**
+         * Path for an npc travelling on the overmap, ordered from dest to src.
+         * Paths are remembered by destination, so an npc following one gets the rest of it
+         * without a new search, as does any other npc standing on it.
+         */
         std::vector<tripoint> get_npc_path( const tripoint &src, const tripoint &dest );
+        /** Returns the path cache statistics since the previous call. */
+        npc_path_cache_stats take_npc_path_stats();
         bool reveal_route( const tripoint &source, const tripoint &dest, int radius = 0,
                            bool road_only = false );
         /**
@@ -495,6 +510,9 @@ class overmapbuffer
         mutable std::set<point> known_non_existing;
         // Cached result of previous call to overmapbuffer::get_existing
         overmap mutable *last_requested_overmap;
+        // Paths found by get_npc_path, by destination
+        std::map<tripoint, std::vector<std::vector<tripoint>>> npc_paths;
+        npc_path_cache_stats npc_path_stats;
 
         /**
          * Get a list of notes in the (loaded) overmaps.
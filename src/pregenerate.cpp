@@ -0,0 +1,159 @@
+#include "game.h" // IWYU pragma: associated
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "coordinate_conversions.h"
+#include "line.h"
+#include "loading_ui.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "worldfactory.h"
+
+// Overmap terrain tiles covered by the cities of an overmap, in global coordinates.
+static std::set<point> city_tiles( const overmap &om )
+{
+    std::set<point> result;
+    const point base = om.global_base_point();
+    for( const city &c : om.cities ) {
+        // Buildings line the streets, so take one more tile than the streets reach
+        const int reach = c.size + 1;
+        for( int x = c.pos.x - reach; x <= c.pos.x + reach; x++ ) {
+            for( int y = c.pos.y - reach; y <= c.pos.y + reach; y++ ) {
+                if( trig_dist( x, y, c.pos.x, c.pos.y ) <= reach ) {
+                    result.emplace( base.x + x, base.y + y );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// Loads the tiles through the map, so that missing submaps are generated and stored in
+// MAPBUFFER exactly as when the player walks there. Returns the number of levels loaded.
+static int generate_city_maps( const std::set<point> &tiles )
+{
+    static const oter_id rock( "empty_rock" );
+    static const oter_id air( "open_air" );
+
+    int levels = 0;
+    tinymap tm;
+    for( const point &omt : tiles ) {
+        const point sm = omt_to_sm_copy( omt );
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            const oter_id &ter = overmap_buffer.ter( omt.x, omt.y, z );
+            if( ter == rock || ter == air ) {
+                continue;
+            }
+            tm.load( sm.x, sm.y, z, false );
+            levels++;
+        }
+    }
+    return levels;
+}
+
+// Overmaps are only read while saving and each goes to its own files, so they are written
+// on all cores.
+static bool save_overmaps( const std::vector<overmap *> &overmaps )
+{
+    const size_t workers = std::min<size_t>( overmaps.size(),
+                           std::max( 1u, std::thread::hardware_concurrency() ) );
+    std::atomic<size_t> next_overmap( 0 );
+    std::vector<std::string> errors( workers );
+    const auto work = [&overmaps, &next_overmap, &errors]( const size_t worker ) {
+        try {
+            for( size_t i = next_overmap++; i < overmaps.size(); i = next_overmap++ ) {
+                overmaps[i]->save();
+            }
+        } catch( const std::exception &err ) {
+            errors[worker] = err.what();
+        }
+    };
+    std::vector<std::thread> threads;
+    for( size_t i = 1; i < workers; i++ ) {
+        threads.emplace_back( work, i );
+    }
+    if( workers > 0 ) {
+        work( 0 );
+    }
+    for( auto &t : threads ) {
+        t.join();
+    }
+
+    bool saved = true;
+    for( const std::string &err : errors ) {
+        if( !err.empty() ) {
+            std::cerr << "Failed to save an overmap: " << err << std::endl;
+            saved = false;
+        }
+    }
+    return saved;
+}
+
+bool game::pregenerate_world( const std::string &world, const int radius, const bool city_maps )
+{
+    world_generator->init();
+    const WORLDPTR wptr = world_generator->get_world( world );
+    if( !wptr ) {
+        std::cerr << "Unknown world: " << world << std::endl;
+        return false;
+    }
+
+    try {
+        world_generator->set_active_world( wptr );
+        loading_ui ui( false );
+        load_core_data( ui );
+        load_world_modfiles( ui );
+        load_master();
+    } catch( const std::exception &err ) {
+        std::cerr << "Error loading world '" << world << "': " << err.what() << std::endl;
+        return false;
+    }
+
+    // New characters start on the overmap at the origin, or as close to it as possible.
+    // Overmaps are generated closest first, one at a time: each one joins its roads and rivers
+    // to the neighbours that already exist and draws from the global random number generator,
+    // so only a fixed order gives the same world for the same seed. Maps look at the terrain
+    // around them, so when they are wanted a ring of overmaps more is needed to draw them.
+    const std::vector<tripoint> order = closest_tripoints_first( radius + ( city_maps ? 1 : 0 ),
+                                        tripoint_zero );
+    std::vector<overmap *> overmaps;
+    try {
+        for( const tripoint &om_pos : order ) {
+            overmaps.push_back( &overmap_buffer.get( om_pos.x, om_pos.y ) );
+            std::cout << "Overmap " << om_pos.x << "," << om_pos.y << " ready [" << overmaps.size()
+                      << "/" << order.size() << "]" << std::endl;
+        }
+        if( city_maps ) {
+            for( const tripoint &om_pos : closest_tripoints_first( radius, tripoint_zero ) ) {
+                const overmap &om = overmap_buffer.get( om_pos.x, om_pos.y );
+                const int levels = generate_city_maps( city_tiles( om ) );
+                MAPBUFFER.save( true );
+                std::cout << "Maps of overmap " << om_pos.x << "," << om_pos.y << " ready ("
+                          << om.cities.size() << " cities, " << levels << " map levels)"
+                          << std::endl;
+            }
+        }
+    } catch( const std::exception &err ) {
+        std::cerr << "Error generating world '" << world << "': " << err.what() << std::endl;
+        return false;
+    }
+
+    std::cout << "Saving " << overmaps.size() << " overmaps" << std::endl;
+    if( !save_overmaps( overmaps ) ) {
+        return false;
+    }
+    // Overmap generation hands out npc ids, the next game must continue after them
+    return save_factions_missions_npcs() && save_artifacts();
+}
@@ -1,6 +1,7 @@
 #include "game.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <map>
 #include <set>
@@ -10,6 +11,7 @@
 
 #include "artifact.h"
 #include "auto_pickup.h"
+#include "cata_utility.h"
 #include "computer.h"
 #include "coordinate_conversions.h"
 #include "creature_tracker.h"
@@ -216,6 +218,9 @@ void game::unserialize( std::istream &fin )
             vdata.read_next( stairtmp );
             coming_to_stairs.push_back( stairtmp );
         }
+        // Followers of the loaded game start a new round of overmap travel
+        overmap_npc_queue.clear();
+        overmap_npc_budget = 0;
 
         JsonObject odata = data.get_object( "kills" );
         std::set<std::string> members = odata.get_member_names();
@@ -825,33 +830,32 @@ void overmap::unserialize( std::istream &fin )
             std::unordered_map<tripoint, std::string> needs_conversion;
             jsin.start_array();
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+                // The runs are kept as they are, the layer is unpacked once it is changed
+                map_layer &l = layer[z];
+                std::vector<std::array<oter_id, OMAPY>>().swap( l.terrain );
+                l.terrain_runs.clear();
+                l.terrain_tiles.clear();
                 jsin.start_array();
-                int count = 0;
                 std::string tmp_ter;
-                oter_id tmp_otid( 0 );
-                for( int j = 0; j < OMAPY; j++ ) {
-                    for( int i = 0; i < OMAPX; i++ ) {
-                        if( count == 0 ) {
-                            jsin.start_array();
-                            jsin.read( tmp_ter );
-                            jsin.read( count );
-                            jsin.end_array();
-                            if( obsolete_terrain( tmp_ter ) ) {
-                                for( int p = i; p < i + count; p++ ) {
-                                    needs_conversion.emplace( tripoint( p, j, z - OVERMAP_DEPTH ),
-                                                              tmp_ter );
-                                }
-                                tmp_otid = oter_id( 0 );
-                            } else if( oter_str_id( tmp_ter ).is_valid() ) {
-                                tmp_otid = oter_id( tmp_ter );
-                            } else {
-                                debugmsg( "Loaded bad ter! ter %s", tmp_ter.c_str() );
-                                tmp_otid = oter_id( 0 );
-                            }
+                int count = 0;
+                for( int end = 0; end < OMAPX * OMAPY; end += count ) {
+                    jsin.start_array();
+                    jsin.read( tmp_ter );
+                    jsin.read( count );
+                    jsin.end_array();
+                    count = clamp( count, 1, OMAPX * OMAPY - end );
+                    oter_id tmp_otid( 0 );
+                    if( obsolete_terrain( tmp_ter ) ) {
+                        for( int p = end; p < end + count; p++ ) {
+                            const tripoint pos( p % OMAPX, p / OMAPX, z - OVERMAP_DEPTH );
+                            needs_conversion.emplace( pos, tmp_ter );
                         }
-                        count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                    } else if( oter_str_id( tmp_ter ).is_valid() ) {
+                        tmp_otid = oter_id( tmp_ter );
+                    } else {
+                        debugmsg( "Loaded bad ter! ter %s", tmp_ter.c_str() );
                     }
+                    l.terrain_runs.emplace_back( end + count, tmp_otid );
                 }
                 jsin.end_array();
             }
@@ -1229,11 +1233,11 @@ void overmap::save_monster_groups( JsonOut &jout ) const
     // Bin groups by their fields, except positions and monsters
     std::unordered_map<mongroup, std::list<tripoint>, mongroup_hash, mongroup_bin_eq> binned_groups;
     binned_groups.reserve( zg.size() );
-    for( const auto &pos_group : zg ) {
+    for( const mongroup &group : zg ) {
         // Each group in bin adds only position
         // so that 100 identical groups are 1 group data and 100 tripoints
-        std::list<tripoint> &positions = binned_groups[pos_group.second];
-        positions.emplace_back( pos_group.first );
+        std::list<tripoint> &positions = binned_groups[group];
+        positions.emplace_back( group.pos );
     }
 
     for( auto &group_bin : binned_groups ) {
@@ -1261,12 +1265,27 @@ void overmap::serialize( std::ostream &fout ) const
     json.member( "layers" );
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        const map_layer &l = layer[z];
+        json.start_array();
+        if( l.terrain.empty() ) {
+            // Still the runs it was loaded from
+            int start = 0;
+            for( const auto &run : l.terrain_runs ) {
+                json.start_array();
+                json.write( run.second.id() );
+                json.write( run.first - start );
+                json.end_array();
+                start = run.first;
+            }
+            json.end_array();
+            fout << std::endl;
+            continue;
+        }
         int count = 0;
         oter_id last_tertype( -1 );
-        json.start_array();
         for( int j = 0; j < OMAPY; j++ ) {
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer[z].terrain[i][j];
+                oter_id t = l.terrain[i][j];
                 if( t != last_tertype ) {
                     if( count ) {
                         json.write( count );
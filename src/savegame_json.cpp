@@ -9,6 +9,8 @@
 #include <limits>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "ammo.h"
 #include "auto_pickup.h"
@@ -2741,27 +2743,53 @@ void player_morale::load( JsonObject &jsin )
 
 void map_memory::store( JsonOut &jsout ) const
 {
+    // Format version, older files start with the list of tiles instead.
     jsout.start_array();
+    jsout.write( 1 );
+
+    // Tile ids are written once, the chunks refer to them by their position in this list.
+    std::unordered_map<uint32_t, int> local_ids;
+    std::vector<uint32_t> used_ids;
+    for( const chunk &c : chunks ) {
+        for( const uint32_t id : c.tiles ) {
+            if( local_ids.emplace( id, static_cast<int>( used_ids.size() ) ).second ) {
+                used_ids.push_back( id );
+            }
+        }
+    }
     jsout.start_array();
-    for( const auto &elem : tile_cache.list() ) {
-        jsout.start_array();
-        jsout.write( elem.first.x );
-        jsout.write( elem.first.y );
-        jsout.write( elem.first.z );
-        jsout.write( elem.second.tile );
-        jsout.write( elem.second.subtile );
-        jsout.write( elem.second.rotation );
-        jsout.end_array();
+    for( const uint32_t id : used_ids ) {
+        jsout.write( tile_id( id ) );
     }
     jsout.end_array();
 
+    // Oldest chunk first, so loading restores the order in which they are forgotten.
     jsout.start_array();
-    for( const auto &elem : symbol_cache.list() ) {
+    for( const chunk &c : chunks ) {
+        jsout.start_array();
+        jsout.write( c.pos.x );
+        jsout.write( c.pos.y );
+        jsout.write( c.pos.z );
+        jsout.start_array();
+        for( const uint32_t id : c.tiles ) {
+            jsout.write( local_ids[id] );
+        }
+        jsout.end_array();
+        jsout.start_array();
+        for( const int subtile : c.subtiles ) {
+            jsout.write( subtile );
+        }
+        jsout.end_array();
         jsout.start_array();
-        jsout.write( elem.first.x );
-        jsout.write( elem.first.y );
-        jsout.write( elem.first.z );
-        jsout.write( elem.second );
+        for( const int rotation : c.rotations ) {
+            jsout.write( rotation );
+        }
+        jsout.end_array();
+        jsout.start_array();
+        for( const int symbol : c.symbols ) {
+            jsout.write( symbol );
+        }
+        jsout.end_array();
         jsout.end_array();
     }
     jsout.end_array();
@@ -2774,12 +2802,15 @@ void map_memory::load( JsonIn &jsin )
     if( jsin.test_object() ) {
         JsonObject jsobj = jsin.get_object();
         load( jsobj );
-    } else {
-        // This file is large enough that it's more than called for to minimize the
-        // amount of data written and read and make it a bit less "friendly",
-        // and use the streaming interface.
-        jsin.start_array();
-        tile_cache.clear();
+        return;
+    }
+    // This file is large enough that it's more than called for to minimize the
+    // amount of data written and read and make it a bit less "friendly",
+    // and use the streaming interface.
+    jsin.start_array();
+    clear();
+    if( !jsin.test_int() ) {
+        // Legacy loading of the per tile lists.
         jsin.start_array();
         while( !jsin.end_array() ) {
             jsin.start_array();
@@ -2794,7 +2825,6 @@ void map_memory::load( JsonIn &jsin )
                            tile, subtile, rotation );
             jsin.end_array();
         }
-        symbol_cache.clear();
         jsin.start_array();
         while( !jsin.end_array() ) {
             jsin.start_array();
@@ -2807,14 +2837,62 @@ void map_memory::load( JsonIn &jsin )
             jsin.end_array();
         }
         jsin.end_array();
+        return;
     }
+
+    jsin.get_int();
+    std::vector<uint32_t> ids;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        ids.push_back( intern_tile_id( jsin.get_string() ) );
+    }
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        jsin.start_array();
+        tripoint pos;
+        pos.x = jsin.get_int();
+        pos.y = jsin.get_int();
+        pos.z = jsin.get_int();
+        chunk &c = touch_chunk( std::numeric_limits<int>::max(), pos );
+        // Each of the arrays has one entry per tile, ignore anything beyond that.
+        int i = 0;
+        jsin.start_array();
+        for( ; !jsin.end_array(); i++ ) {
+            const int id = jsin.get_int();
+            if( i < chunk_tiles && id >= 0 && static_cast<size_t>( id ) < ids.size() ) {
+                c.tiles[i] = ids[id];
+            }
+        }
+        jsin.start_array();
+        for( i = 0; !jsin.end_array(); i++ ) {
+            const int subtile = jsin.get_int();
+            if( i < chunk_tiles ) {
+                c.subtiles[i] = subtile;
+            }
+        }
+        jsin.start_array();
+        for( i = 0; !jsin.end_array(); i++ ) {
+            const int rotation = jsin.get_int();
+            if( i < chunk_tiles ) {
+                c.rotations[i] = rotation;
+            }
+        }
+        jsin.start_array();
+        for( i = 0; !jsin.end_array(); i++ ) {
+            const int symbol = jsin.get_int();
+            if( i < chunk_tiles ) {
+                c.symbols[i] = symbol;
+            }
+        }
+        jsin.end_array();
+    }
+    jsin.end_array();
 }
 
-// Deserializer for legacy object-based memory map.
 void map_memory::load( JsonObject &jsin )
 {
+    clear();
     JsonArray map_memory_tiles = jsin.get_array( "map_memory_tiles" );
-    tile_cache.clear();
     while( map_memory_tiles.has_more() ) {
         JsonObject pmap = map_memory_tiles.next_object();
         const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
@@ -2823,7 +2901,6 @@ void map_memory::load( JsonObject &jsin )
     }
 
     JsonArray map_memory_curses = jsin.get_array( "map_memory_curses" );
-    symbol_cache.clear();
     while( map_memory_curses.has_more() ) {
         JsonObject pmap = map_memory_curses.next_object();
         const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
@@ -102,6 +102,11 @@ class Font
          * using (curses) color.
          */
         virtual void OutputChar( const std::string &ch, int x, int y, unsigned char color ) = 0;
+        /** Draws the character of a console cell, fonts can look it up without decoding it. */
+        virtual void OutputChar( const cata_cursesport::cursecell &cell, int x, int y,
+                                 unsigned char color ) {
+            OutputChar( cell.str(), x, y, color );
+        }
         virtual void draw_ascii_lines( unsigned char line_id, int drawx, int drawy, int FG ) const;
         bool draw_window( const catacurses::window &w );
         bool draw_window( const catacurses::window &w, int offsetx, int offsety );
@@ -119,7 +124,7 @@ class Font
 };
 
 /**
- * Uses a ttf font. Its glyphs are cached.
+ * Uses a ttf font. Its glyphs are rendered once and packed into atlas textures.
  */
 class CachedTTFFont : public Font
 {
@@ -128,12 +133,38 @@ class CachedTTFFont : public Font
         ~CachedTTFFont() override = default;
 
         void OutputChar( const std::string &ch, int x, int y, unsigned char color ) override;
+        void OutputChar( const cata_cursesport::cursecell &cell, int x, int y,
+                         unsigned char color ) override;
     protected:
-        SDL_Texture_Ptr create_glyph( const std::string &ch, int color );
+        /** Where a glyph is in the atlas textures. */
+        struct glyph_t {
+            bool loaded = false;
+            // nullptr if the glyph could not be rendered
+            SDL_Texture *atlas = nullptr;
+            SDL_Rect src;
+            int width = 0;
+        };
+
+        SDL_Surface_Ptr create_glyph( const std::string &ch, int color );
+        glyph_t add_glyph( const std::string &ch, int color );
+        void draw_glyph( const glyph_t &glyph, int x, int y );
 
         TTF_Font_Ptr font;
-        // Maps (character code, color) to SDL_Texture*
 
+        // Glyphs are packed in rows, copying them from a few big textures instead of one
+        // texture each lets the renderer batch the copies of a whole window.
+        static constexpr int atlas_size = 1024;
+        std::vector<SDL_Texture_Ptr> atlases;
+        int atlas_x = 0;
+        int atlas_y = 0;
+        int atlas_row_height = 0;
+
+        // Single code points are looked up by index, in pages of 256 code points by 16 colors
+        static constexpr int glyph_page_size = 256;
+        using glyph_page = std::array<glyph_t, glyph_page_size * 16>;
+        std::vector<std::unique_ptr<glyph_page>> glyph_pages;
+
+        // Maps (character code, color) to glyph, for everything that is not a single code point
         struct key_t {
             std::string   codepoints;
             unsigned char color;
@@ -144,12 +175,7 @@ class CachedTTFFont : public Font
             }
         };
 
-        struct cached_t {
-            SDL_Texture_Ptr texture;
-            int          width;
-        };
-
-        std::map<key_t, cached_t> glyph_cache_map;
+        std::map<key_t, glyph_t> glyph_cache_map;
 
         const bool fontblending;
 };
@@ -165,6 +191,8 @@ class BitmapFont : public Font
         ~BitmapFont() override = default;
 
         void OutputChar( const std::string &ch, int x, int y, unsigned char color ) override;
+        void OutputChar( const cata_cursesport::cursecell &cell, int x, int y,
+                         unsigned char color ) override;
         void OutputChar( long t, int x, int y, unsigned char color );
         void draw_ascii_lines( unsigned char line_id, int drawx, int drawy, int FG ) const override;
     protected:
@@ -579,13 +607,13 @@ inline void FillRectDIB( int x, int y, int width, int height, unsigned char colo
     FillRectDIB( rect, color );
 }
 
-SDL_Texture_Ptr CachedTTFFont::create_glyph( const std::string &ch, const int color )
+SDL_Surface_Ptr CachedTTFFont::create_glyph( const std::string &ch, const int color )
 {
     const auto function = fontblending ? TTF_RenderUTF8_Blended : TTF_RenderUTF8_Solid;
     SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), windowsPalette[color] ) );
     if( !sglyph ) {
         dbg( D_ERROR ) << "Failed to create glyph for " << ch << ": " << TTF_GetError();
-        return NULL;
+        return nullptr;
     }
     /* SDL interprets each pixel as a 32-bit number, so our masks must depend
        on the endianness (byte order) of the machine */
@@ -627,48 +655,135 @@ SDL_Texture_Ptr CachedTTFFont::create_glyph( const std::string &ch, const int co
         sglyph = std::move( surface );
     }
 
-    return CreateTextureFromSurface( renderer, sglyph );
+    return sglyph;
+}
+
+CachedTTFFont::glyph_t CachedTTFFont::add_glyph( const std::string &ch, const int color )
+{
+    glyph_t result;
+    result.loaded = true;
+    result.width = fontwidth * utf8_wrapper( ch ).display_width();
+    const SDL_Surface_Ptr sglyph = create_glyph( ch, color );
+    if( !sglyph || sglyph->w + 1 > atlas_size || sglyph->h + 1 > atlas_size ) {
+        return result;
+    }
+    // Glyphs are kept a pixel apart, so scaling doesn't blend in their neighbours
+    if( atlas_x + sglyph->w + 1 > atlas_size ) {
+        atlas_x = 0;
+        atlas_y += atlas_row_height;
+        atlas_row_height = 0;
+    }
+    if( atlases.empty() || atlas_y + sglyph->h + 1 > atlas_size ) {
+        SDL_Texture_Ptr atlas( SDL_CreateTexture( renderer.get(), SDL_PIXELFORMAT_ARGB8888,
+                               SDL_TEXTUREACCESS_STATIC, atlas_size, atlas_size ) );
+        if( printErrorIf( !atlas, "SDL_CreateTexture failed" ) ) {
+            return result;
+        }
+        const std::vector<Uint32> transparent( atlas_size * atlas_size, 0 );
+        printErrorIf( SDL_UpdateTexture( atlas.get(), nullptr, transparent.data(),
+                                         atlas_size * sizeof( Uint32 ) ) != 0,
+                      "SDL_UpdateTexture failed" );
+        printErrorIf( SDL_SetTextureBlendMode( atlas.get(), SDL_BLENDMODE_BLEND ) != 0,
+                      "SDL_SetTextureBlendMode failed" );
+        atlases.push_back( std::move( atlas ) );
+        atlas_x = 0;
+        atlas_y = 0;
+        atlas_row_height = 0;
+    }
+    const SDL_Surface_Ptr converted( SDL_ConvertSurfaceFormat( sglyph.get(),
+                                     SDL_PIXELFORMAT_ARGB8888, 0 ) );
+    if( printErrorIf( !converted, "SDL_ConvertSurfaceFormat failed" ) ) {
+        return result;
+    }
+    const SDL_Rect src = { atlas_x, atlas_y, converted->w, converted->h };
+    if( printErrorIf( SDL_UpdateTexture( atlases.back().get(), &src, converted->pixels,
+                                         converted->pitch ) != 0, "SDL_UpdateTexture failed" ) ) {
+        return result;
+    }
+    atlas_x += src.w + 1;
+    atlas_row_height = std::max( atlas_row_height, src.h + 1 );
+    result.atlas = atlases.back().get();
+    result.src = src;
+    return result;
 }
 
-void CachedTTFFont::OutputChar( const std::string &ch, const int x, const int y,
-                                const unsigned char color )
+void CachedTTFFont::draw_glyph( const glyph_t &glyph, const int x, const int y )
 {
-    key_t    key {std::move( ch ), static_cast<unsigned char>( color & 0xf )};
-
-    auto it = glyph_cache_map.find( key );
-    if( it == std::end( glyph_cache_map ) ) {
-        cached_t new_entry {
-            create_glyph( key.codepoints, key.color ),
-            static_cast<int>( fontwidth * utf8_wrapper( key.codepoints ).display_width() )
-        };
-        it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
-    }
-    const cached_t &value = it->second;
-
-    if( !value.texture ) {
+    if( glyph.atlas == nullptr ) {
         // Nothing we can do here )-:
         return;
     }
-    SDL_Rect rect {x, y, value.width, fontheight};
+    SDL_Rect rect {x, y, glyph.width, fontheight};
 #if defined(__ANDROID__)
     if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), opacity * 255.0f );
+        SDL_SetTextureAlphaMod( glyph.atlas, opacity * 255.0f );
     }
 #endif
-    RenderCopy( renderer, value.texture, nullptr, &rect );
+    printErrorIf( SDL_RenderCopy( renderer.get(), glyph.atlas, &glyph.src, &rect ) != 0,
+                  "SDL_RenderCopy failed" );
 #if defined(__ANDROID__)
     if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), 255 );
+        SDL_SetTextureAlphaMod( glyph.atlas, 255 );
     }
 #endif
 }
 
+void CachedTTFFont::OutputChar( const std::string &ch, const int x, const int y,
+                                const unsigned char color )
+{
+    key_t    key {ch, static_cast<unsigned char>( color & 0xf )};
+
+    auto it = glyph_cache_map.find( key );
+    if( it == std::end( glyph_cache_map ) ) {
+        glyph_t glyph = add_glyph( key.codepoints, key.color );
+        it = glyph_cache_map.emplace( std::move( key ), glyph ).first;
+    }
+    draw_glyph( it->second, x, y );
+}
+
+// Number of bytes of the UTF-8 encoding of a code point
+static int utf8_size( const uint32_t codepoint )
+{
+    return codepoint < 0x80 ? 1 : codepoint < 0x800 ? 2 : codepoint < 0x10000 ? 3 : 4;
+}
+
+void CachedTTFFont::OutputChar( const cata_cursesport::cursecell &cell, const int x, const int y,
+                                const unsigned char color )
+{
+    if( cell.empty() || cell.codepoint == UNKNOWN_UNICODE ||
+        cell.size != utf8_size( cell.codepoint ) ) {
+        // Combining characters or invalid UTF-8
+        OutputChar( cell.str(), x, y, color );
+        return;
+    }
+    const size_t page = cell.codepoint / glyph_page_size;
+    if( page >= glyph_pages.size() ) {
+        glyph_pages.resize( page + 1 );
+    }
+    if( !glyph_pages[page] ) {
+        glyph_pages[page].reset( new glyph_page() );
+    }
+    const int color_index = color & 0xf;
+    const size_t index = ( cell.codepoint % glyph_page_size ) * 16 + color_index;
+    glyph_t &glyph = ( *glyph_pages[page] )[index];
+    if( !glyph.loaded ) {
+        glyph = add_glyph( cell.str(), color_index );
+    }
+    draw_glyph( glyph, x, y );
+}
+
 void BitmapFont::OutputChar( const std::string &ch, int x, int y, unsigned char color )
 {
     const long t = UTF8_getch( ch );
     BitmapFont::OutputChar( t, x, y, color );
 }
 
+void BitmapFont::OutputChar( const cata_cursesport::cursecell &cell, int x, int y,
+                             unsigned char color )
+{
+    BitmapFont::OutputChar( static_cast<long>( cell.codepoint ), x, y, color );
+}
+
 void BitmapFont::OutputChar( long t, int x, int y, unsigned char color )
 {
     if( t > 256 ) {
@@ -1199,9 +1314,6 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
         }
     }
 
-    // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
-    static const std::string space_string = " ";
-
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
@@ -1241,25 +1353,25 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
             }
             oldcell = cell;
 
-            if( cell.ch.empty() ) {
+            if( cell.empty() ) {
                 continue; // second cell of a multi-cell character
             }
 
             // Spaces are used a lot, so this does help noticeably
-            if( cell.ch == space_string ) {
+            if( cell.is_space() ) {
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, cell.BG );
                 continue;
             }
-            const int codepoint = UTF8_getch( cell.ch );
+            const int codepoint = cell.codepoint;
             const catacurses::base_color FG = cell.FG;
             const catacurses::base_color BG = cell.BG;
-            int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
+            const int cw = cell.width;
             if( cw < 1 ) {
                 // utf8_width() may return a negative width
                 continue;
             }
             bool use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
-            unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
+            unsigned char uc = static_cast<unsigned char>( cell.bytes[0] );
             switch( codepoint ) {
                 case LINE_XOXO_UNICODE:
                     uc = LINE_XOXO_C;
@@ -1305,7 +1417,7 @@ bool Font::draw_window( const catacurses::window &w, const int offsetx, const in
             if( use_draw_ascii_lines_routine ) {
                 draw_ascii_lines( uc, drawx, drawy, FG );
             } else {
-                OutputChar( cell.ch, drawx, drawy, FG );
+                OutputChar( cell, drawx, drawy, FG );
             }
         }
     }
@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <climits>
 #include <cmath>
+#include <cstdlib>
 
+#include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
 #include "effect.h"
@@ -205,10 +208,128 @@ int get_signal_for_hordes( const centroid &centr )
     return 0;
 }
 
+// Extra distance a sound travels when passing through a wall, a closed door or window
+static constexpr int sound_wall_damping = 10;
+// Extra distance a sound travels per z-level between it and the listener
+static constexpr int sound_floor_damping = 10;
+
+/**
+ * How far a sound has to travel to reach the tiles of its z-level, going around walls or
+ * being muffled by them. Every step costs 1, stepping into a tile with impassable terrain or
+ * furniture costs @ref sound_wall_damping extra. Smoke and darkness don't muffle anything.
+ * The field is flooded with a bucket queue up to the distance at which the sound can't be
+ * heard anymore. A sound from beyond the edge of the map enters it at the closest tile.
+ */
+class sound_field
+{
+    public:
+        sound_field() {
+            std::fill_n( &distance[0][0], MAPSIZE_X * MAPSIZE_Y, INT_MAX );
+        }
+
+        void flood( const tripoint &source, int reach );
+
+        /** The map may have changed, walls have to be looked up again on the next flood. */
+        void forget_walls() {
+            walls_z = INT_MIN;
+        }
+
+        /** Extra distance on top of the straight line to the tile, or -1 if it's out of reach. */
+        int detour( const point &p ) const {
+            const int dist = distance[p.x][p.y];
+            return dist == INT_MAX ? -1 : dist - square_dist( source.x, source.y, p.x, p.y );
+        }
+
+    private:
+        void find_walls( int z );
+
+        int distance[MAPSIZE_X][MAPSIZE_Y];
+        // Tiles that muffle sounds on z-level walls_z
+        bool walls[MAPSIZE_X][MAPSIZE_Y];
+        int walls_z = INT_MIN;
+        // Area touched by the last flood, only that needs to be reset for the next one
+        point min;
+        point max;
+        tripoint source;
+        std::vector<std::vector<point>> buckets;
+};
+
+void sound_field::find_walls( const int z )
+{
+    walls_z = z;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            walls[x][y] = g->m.impassable_ter_furn( tripoint( x, y, z ) );
+        }
+    }
+}
+
+void sound_field::flood( const tripoint &src, int reach )
+{
+    for( int x = min.x; x < max.x; x++ ) {
+        std::fill( &distance[x][min.y], &distance[x][max.y], INT_MAX );
+    }
+    source = tripoint( clamp( src.x, 0, MAPSIZE_X - 1 ), clamp( src.y, 0, MAPSIZE_Y - 1 ), src.z );
+    reach -= rl_dist( src, source );
+    min = point( std::max( 0, source.x - reach ), std::max( 0, source.y - reach ) );
+    max = point( std::min( MAPSIZE_X, source.x + reach + 1 ),
+                 std::min( MAPSIZE_Y, source.y + reach + 1 ) );
+    if( reach <= 0 || !g->m.inbounds( source ) ) {
+        max = min;
+        return;
+    }
+
+    if( walls_z != source.z ) {
+        find_walls( source.z );
+    }
+    if( buckets.size() < static_cast<size_t>( reach ) + 1 ) {
+        buckets.resize( reach + 1 );
+    }
+    distance[source.x][source.y] = 0;
+    buckets[0].emplace_back( source.x, source.y );
+    for( int dist = 0; dist <= reach; dist++ ) {
+        // Steps cost at least 1, so nothing gets added to the bucket being processed
+        for( const point &p : buckets[dist] ) {
+            if( distance[p.x][p.y] != dist ) {
+                // Already reached on a shorter path
+                continue;
+            }
+            const int max_x = std::min( max.x - 1, p.x + 1 );
+            const int max_y = std::min( max.y - 1, p.y + 1 );
+            for( int x = std::max( min.x, p.x - 1 ); x <= max_x; x++ ) {
+                for( int y = std::max( min.y, p.y - 1 ); y <= max_y; y++ ) {
+                    const int step = walls[x][y] ? 1 + sound_wall_damping : 1;
+                    const int next = dist + step;
+                    if( next <= reach && next < distance[x][y] ) {
+                        distance[x][y] = next;
+                        buckets[next].emplace_back( x, y );
+                    }
+                }
+            }
+        }
+        buckets[dist].clear();
+    }
+}
+
 void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = weather_data( g->weather ).sound_attn;
+
+    // Sort the monsters into buckets by submap, so that each sound only has to look at the
+    // monsters in the submaps it can reach.
+    std::vector<std::vector<monster *>> monster_buckets( MAPSIZE * MAPSIZE );
+    if( !sound_clusters.empty() ) {
+        for( monster &critter : g->all_monsters() ) {
+            if( g->m.inbounds( critter.pos() ) ) {
+                const int bucket = critter.posx() / SEEX + critter.posy() / SEEY * MAPSIZE;
+                monster_buckets[bucket].push_back( &critter );
+            }
+        }
+    }
+    static sound_field field;
+    field.forget_walls();
+
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -226,12 +347,31 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
-            // TODO: Generalize this to Creature::hear_sound
-            const int dist = rl_dist( source, critter.pos() );
-            if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
+        // Nothing hears sounds from further away than twice their volume.
+        const int reach = vol * 2 - 1;
+        if( reach <= 0 ) {
+            continue;
+        }
+        field.flood( source, reach );
+        const int min_gx = std::max( 0, ( source.x - reach ) / SEEX );
+        const int min_gy = std::max( 0, ( source.y - reach ) / SEEY );
+        const int max_gx = std::min( MAPSIZE - 1, ( source.x + reach ) / SEEX );
+        const int max_gy = std::min( MAPSIZE - 1, ( source.y + reach ) / SEEY );
+        for( int gy = min_gy; gy <= max_gy; gy++ ) {
+            for( int gx = min_gx; gx <= max_gx; gx++ ) {
+                for( monster *critter : monster_buckets[gx + gy * MAPSIZE] ) {
+                    // TODO: Generalize this to Creature::hear_sound
+                    const int detour = field.detour( point( critter->posx(), critter->posy() ) );
+                    if( detour < 0 ) {
+                        continue;
+                    }
+                    const int dist = rl_dist( source, critter->pos() ) + detour +
+                                     sound_floor_damping * std::abs( critter->posz() - source.z );
+                    if( vol * 2 > dist ) {
+                        // Exclude monsters that certainly won't hear the sound
+                        critter->hear_sound( source, vol, dist );
+                    }
+                }
             }
         }
     }
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <new>
 
 #include "mapdata.h"
 #include "trap.h"
@@ -16,10 +17,24 @@ submap::submap()
     std::uninitialized_fill_n( &lum[0][0], elements, 0 );
     std::uninitialized_fill_n( &trp[0][0], elements, tr_null );
     std::uninitialized_fill_n( &rad[0][0], elements, 0 );
+    // A new submap may replace one that held different items at the same place.
+    std::uninitialized_fill_n( &item_stamp[0][0], elements, ++item_change_clock );
+
+    // The item lists have already been default constructed, but they need to use the arena
+    // of this submap. Nothing has been allocated yet, so they can simply be rebuilt in place.
+    const arena_allocator<item> alloc( &item_nodes );
+    for( auto &column : itm ) {
+        for( item_list &items : column ) {
+            items.~item_list();
+            new( &items ) item_list( alloc );
+        }
+    }
 
     is_uniform = false;
 }
 
+std::atomic<uint64_t> submap::item_change_clock( 0 );
+
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 static const std::string COSMETICS_SIGNAGE( "SIGNAGE" );
 // Handle GCC warning: 'warning: returning reference to temporary'
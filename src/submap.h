@@ -2,7 +2,8 @@
 #ifndef SUBMAP_H
 #define SUBMAP_H
 
-#include <list>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #include "game_constants.h"
 #include "int_id.h"
 #include "item.h"
+#include "item_arena.h"
 #include "string_id.h"
 
 class map;
@@ -112,6 +114,11 @@ struct submap {
         }
     }
 
+    /** Marks the items on a square as changed, see item_stamp. */
+    void items_changed( const point &p ) {
+        item_stamp[p.x][p.y] = ++item_change_clock;
+    }
+
     struct cosmetic_t {
         point pos;
         std::string type;
@@ -150,10 +157,15 @@ struct submap {
     ter_id          ter[SEEX][SEEY];  // Terrain on each square
     furn_id         frn[SEEX][SEEY];  // Furniture on each square
     std::uint8_t    lum[SEEX][SEEY];  // Number of items emitting light on each square
-    std::list<item> itm[SEEX][SEEY];  // Items on each square
+    item_arena      item_nodes;       // Storage for the items below, must outlive them
+    item_list       itm[SEEX][SEEY];  // Items on each square
     field           fld[SEEX][SEEY];  // Field on each square
     trap_id         trp[SEEX][SEEY];  // Trap on each square
     int             rad[SEEX][SEEY];  // Irradiation of each square
+    // Value of item_change_clock when the items on each square were last added or removed.
+    // Items changed in place through a map_stack don't update it.
+    uint64_t        item_stamp[SEEX][SEEY];
+    static std::atomic<uint64_t> item_change_clock;
 
     // If is_uniform is true, this submap is a solid block of terrain
     // Uniform submaps aren't saved/loaded, because regenerating them is faster
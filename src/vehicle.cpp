@@ -69,7 +69,7 @@ inline int modulo( int v, int m );
 point vehicles::cardinal_d[5] = { point( -1, 0 ), point( 1, 0 ), point( 0, -1 ), point( 0, 1 ), point_zero };
 
 // Vehicle stack methods.
-std::list<item>::iterator vehicle_stack::erase( std::list<item>::iterator it )
+vehicle_stack::iterator vehicle_stack::erase( iterator it )
 {
     return myorigin->remove_item( part_num, it );
 }
@@ -79,7 +79,7 @@ void vehicle_stack::push_back( const item &newitem )
     myorigin->add_item( part_num, newitem );
 }
 
-void vehicle_stack::insert_at( std::list<item>::iterator index,
+void vehicle_stack::insert_at( iterator index,
                                const item &newitem )
 {
     myorigin->add_item_at( part_num, index, newitem );
@@ -122,7 +122,11 @@ vehicle::vehicle() : vehicle( vproto_id() )
     smz = 0;
 }
 
-vehicle::~vehicle() = default;
+vehicle::~vehicle()
+{
+    // Cables of other vehicles may lead here
+    invalidate_power_grids();
+}
 
 bool vehicle::player_in_control( const player &p ) const
 {
@@ -3965,24 +3969,28 @@ vehicle *vehicle::find_vehicle( const tripoint &where )
     return nullptr;
 }
 
-template <typename Func, typename Vehicle>
-int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action )
+unsigned long vehicle::power_grid_changes = 0;
+
+const std::vector<std::pair<vehicle *, int>> &vehicle::get_power_grid() const
 {
+    if( power_grid_owner == this && power_grid_version == power_grid_changes ) {
+        return power_grid;
+    }
+    power_grid.clear();
+
     // Breadth-first search! Initialize the queue with a pointer to ourselves and go!
-    std::queue< std::pair<Vehicle *, int> > connected_vehs;
-    std::set<Vehicle *> visited_vehs;
-    connected_vehs.push( std::make_pair( start_veh, 0 ) );
+    std::queue< std::pair<const vehicle *, int> > connected_vehs;
+    std::set<const vehicle *> visited_vehs;
+    connected_vehs.push( std::make_pair( this, 0 ) );
 
-    while( amount > 0 && !connected_vehs.empty() ) {
+    while( !connected_vehs.empty() ) {
         auto current_node = connected_vehs.front();
-        Vehicle *current_veh = current_node.first;
+        const vehicle *current_veh = current_node.first;
         int current_loss = current_node.second;
 
         visited_vehs.insert( current_veh );
         connected_vehs.pop();
 
-        g->u.add_msg_if_player( m_debug, "Traversing graph with %d power", amount );
-
         for( auto &p : current_veh->loose_parts ) {
             if( !current_veh->part_info( p ).has_flag( "POWER_TRANSFER" ) ) {
                 continue; // ignore loose parts that aren't power transfer cables
@@ -3995,24 +4003,37 @@ int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action
                 continue;
             }
 
-            // Add this connected vehicle to the queue of vehicles to search next,
-            // but only if we haven't seen this one before.
-            if( visited_vehs.count( target_veh ) < 1 ) {
-                int target_loss = current_loss + current_veh->part_info( p ).epower;
-                connected_vehs.push( std::make_pair( target_veh, target_loss ) );
-
-                float loss_amount = ( static_cast<float>( amount ) * static_cast<float>( target_loss ) ) / 100;
-                g->u.add_msg_if_player( m_debug, "Visiting remote %p with %d power (loss %f, which is %d percent)",
-                                        ( void * )target_veh, amount, loss_amount, target_loss );
+            // Add this connected vehicle to the queue of vehicles to search next.
+            int target_loss = current_loss + current_veh->part_info( p ).epower;
+            connected_vehs.push( std::make_pair( target_veh, target_loss ) );
+            power_grid.emplace_back( target_veh, target_loss );
+        }
+    }
 
-                amount = action( target_veh, amount, static_cast<int>( loss_amount ) );
-                g->u.add_msg_if_player( m_debug, "After remote %p, %d power", ( void * )target_veh, amount );
+    // Looking up the vehicles may have loaded submaps, which doesn't change any cables
+    power_grid_owner = this;
+    power_grid_version = power_grid_changes;
+    return power_grid;
+}
 
-                if( amount < 1 ) {
-                    break; // No more charge to donate away.
-                }
-            }
+template <typename Func, typename Vehicle>
+int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action )
+{
+    // The visitor may change the grid (e.g. by destroying a vehicle), so walk a copy of it.
+    const std::vector<std::pair<vehicle *, int>> grid = start_veh->get_power_grid();
+    for( const auto &node : grid ) {
+        if( amount < 1 ) {
+            break; // No more charge to donate away.
         }
+        vehicle *target_veh = node.first;
+        const int target_loss = node.second;
+
+        float loss_amount = ( static_cast<float>( amount ) * static_cast<float>( target_loss ) ) / 100;
+        g->u.add_msg_if_player( m_debug, "Visiting remote %p with %d power (loss %f, which is %d percent)",
+                                ( void * )target_veh, amount, loss_amount, target_loss );
+
+        amount = action( target_veh, amount, static_cast<int>( loss_amount ) );
+        g->u.add_msg_if_player( m_debug, "After remote %p, %d power", ( void * )target_veh, amount );
     }
     return amount;
 }
@@ -4157,6 +4178,24 @@ void vehicle::idle( bool on_map )
     }
 }
 
+bool vehicle::is_active_off_map() const
+{
+    if( engine_on ) {
+        return true;
+    }
+    for( const int elem : reactors ) {
+        if( is_part_on( elem ) ) {
+            return true;
+        }
+    }
+    for( const vpart_reference &vp : get_enabled_parts( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
+        if( vp.info().epower != 0 ) {
+            return true;
+        }
+    }
+    return !empty( get_enabled_parts( "PLANTER" ) );
+}
+
 void vehicle::on_move()
 {
     if( has_part( "SCOOP", true ) ) {
@@ -4303,7 +4342,7 @@ bool vehicle::add_item( vehicle_part &pt, const item &obj )
     return add_item( idx, obj );
 }
 
-bool vehicle::add_item_at( int part, std::list<item>::iterator index, item itm )
+bool vehicle::add_item_at( int part, item_stack::iterator index, item itm )
 {
     if( itm.is_bucket_nonempty() ) {
         for( auto &elem : itm.contents ) {
@@ -4335,7 +4374,7 @@ bool vehicle::remove_item( int part, int itemdex )
 bool vehicle::remove_item( int part, const item *it )
 {
     bool rc = false;
-    std::list<item> &veh_items = parts[part].items;
+    item_list &veh_items = parts[part].items;
 
     for( auto iter = veh_items.begin(); iter != veh_items.end(); iter++ ) {
         //delete the item if the pointer memory addresses are the same
@@ -4348,9 +4387,9 @@ bool vehicle::remove_item( int part, const item *it )
     return rc;
 }
 
-std::list<item>::iterator vehicle::remove_item( int part, std::list<item>::iterator it )
+item_stack::iterator vehicle::remove_item( int part, item_stack::iterator it )
 {
-    std::list<item> &veh_items = parts[part].items;
+    item_list &veh_items = parts[part].items;
 
     if( active_items.has( it, parts[part].mount ) ) {
         active_items.remove( it, parts[part].mount );
@@ -4528,6 +4567,8 @@ void vehicle::enable_refresh()
  */
 void vehicle::refresh()
 {
+    // Power cables might have been added or removed
+    invalidate_power_grids();
     if( no_refresh ) {
         return;
     }
@@ -99,11 +99,11 @@ class vehicle_stack : public item_stack
         vehicle *myorigin;
         int part_num;
     public:
-        vehicle_stack( std::list<item> *newstack, point newloc, vehicle *neworigin, int part ) :
+        vehicle_stack( item_list *newstack, point newloc, vehicle *neworigin, int part ) :
             item_stack( newstack ), location( newloc ), myorigin( neworigin ), part_num( part ) {}
-        std::list<item>::iterator erase( std::list<item>::iterator it ) override;
+        iterator erase( iterator it ) override;
         void push_back( const item &newitem ) override;
-        void insert_at( std::list<item>::iterator index, const item &newitem ) override;
+        void insert_at( iterator index, const item &newitem ) override;
         int count_limit() const override {
             return MAX_ITEM_IN_VEHICLE_STORAGE;
         }
@@ -362,7 +362,7 @@ struct vehicle_part {
         mutable const vpart_info *info_cache = nullptr;
 
         item base;
-        std::list<item> items; // inventory
+        item_list items; // inventory
 
         /** Preferred ammo type when multiple are available */
         itype_id ammo_pref = "null";
@@ -648,6 +648,27 @@ class vehicle
          */
         template <typename Func, typename Vehicle>
         static int traverse_vehicle_graph( Vehicle *start_veh, int amount, Func visitor );
+
+        /**
+         * The vehicles connected to this one through power cables, in the order
+         * @ref traverse_vehicle_graph visits them, with the accumulated power loss
+         * (in percent) to each. Cached until @ref invalidate_power_grids is called.
+         */
+        const std::vector<std::pair<vehicle *, int>> &get_power_grid() const;
+        // Cached result of get_power_grid, valid while power_grid_version matches
+        mutable std::vector<std::pair<vehicle *, int>> power_grid;
+        mutable const vehicle *power_grid_owner = nullptr;
+        mutable unsigned long power_grid_version = 0;
+        static unsigned long power_grid_changes;
+    public:
+        /**
+         * Drops the cached power grids of all vehicles. Must be called whenever a vehicle
+         * appears, disappears, moves or changes its parts, as any of these can connect or
+         * disconnect cables.
+         */
+        static void invalidate_power_grids() {
+            power_grid_changes++;
+        }
     public:
         vehicle( const vproto_id &type_id, int veh_init_fuel = -1, int veh_init_status = -1 );
         vehicle();
@@ -1168,6 +1189,12 @@ class vehicle
 
         // idle fuel consumption
         void idle( bool on_map = true );
+        /**
+         * Whether @ref idle has anything to do for this vehicle while it is outside of the
+         * reality bubble: running engines, reactors and powered parts use up fuel and
+         * batteries, planters turn off in the cold.
+         */
+        bool is_active_off_map() const;
         // continuous processing for running vehicle alarms
         void alarm();
         // leak from broken tanks
@@ -1198,8 +1225,10 @@ class vehicle
 
         // Handle given part collision with vehicle, monster/NPC/player or terrain obstacle
         // Returns collision, which has type, impulse, part, & target.
+        // If may_hit_vehicles is false, the caller made sure there is no other vehicle at p.
         veh_collision part_collision( int part, const tripoint &p,
-                                      bool just_detect, bool bash_floor );
+                                      bool just_detect, bool bash_floor,
+                                      bool may_hit_vehicles = true );
 
         // Process the trap beneath
         void handle_trap( const tripoint &p, int part );
@@ -1239,12 +1268,12 @@ class vehicle
          * Position specific item insertion that skips a bunch of safety checks
          * since it should only ever be used by item processing code.
          */
-        bool add_item_at( int part, std::list<item>::iterator index, item itm );
+        bool add_item_at( int part, item_stack::iterator index, item itm );
 
         // remove item from part's cargo
         bool remove_item( int part, int itemdex );
         bool remove_item( int part, const item *it );
-        std::list<item>::iterator remove_item( int part, std::list<item>::iterator it );
+        item_stack::iterator remove_item( int part, item_stack::iterator it );
 
         vehicle_stack get_items( int part ) const;
         vehicle_stack get_items( int part );
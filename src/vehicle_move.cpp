@@ -337,16 +337,34 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
 
     const int velocity_before = coll_velocity;
     const int sign_before = sgn( velocity_before );
-    bool empty = true;
+
+    // Broadphase: where the structure parts go due to movement (dx/dy/dz) and turning
+    // (precalc[1]), and which other vehicles are close enough to be hit at all.
+    std::vector<std::pair<int, tripoint>> targets;
+    const tripoint pos = global_pos3() + dp;
+    rectangle area( point( pos.x, pos.y ), point( pos.x, pos.y ) );
     for( int p = 0; static_cast<size_t>( p ) < parts.size(); p++ ) {
         if( part_info( p ).location != part_location_structure || parts[ p ].removed ) {
             continue;
         }
-        empty = false;
-        // Coordinates of where part will go due to movement (dx/dy/dz)
-        //  and turning (precalc[1])
-        const tripoint dsp = global_pos3() + dp + parts[p].precalc[1];
-        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor );
+        const tripoint dsp = pos + parts[p].precalc[1];
+        targets.emplace_back( p, dsp );
+        area.p_min = point( std::min( area.p_min.x, dsp.x ), std::min( area.p_min.y, dsp.y ) );
+        area.p_max = point( std::max( area.p_max.x, dsp.x ), std::max( area.p_max.y, dsp.y ) );
+    }
+    const std::vector<rectangle> vehicle_areas = bash_floor ? std::vector<rectangle>() :
+            g->m.get_vehicle_areas( area, pos.z, this );
+
+    const bool empty = targets.empty();
+    for( const auto &target : targets ) {
+        const int p = target.first;
+        const tripoint &dsp = target.second;
+        const bool may_hit_vehicles = std::any_of( vehicle_areas.begin(), vehicle_areas.end(),
+        [&dsp]( const rectangle & r ) {
+            return r.p_min.x <= dsp.x && dsp.x <= r.p_max.x &&
+                   r.p_min.y <= dsp.y && dsp.y <= r.p_max.y;
+        } );
+        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor, may_hit_vehicles );
         if( coll.type == veh_coll_nothing ) {
             continue;
         }
@@ -396,24 +414,22 @@ void terrain_collision_data( const tripoint &p, bool bash_floor,
 }
 
 veh_collision vehicle::part_collision( int part, const tripoint &p,
-                                       bool just_detect, bool bash_floor )
+                                       bool just_detect, bool bash_floor, bool may_hit_vehicles )
 {
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != smz;
-    const bool pl_ctrl = player_in_control( g->u );
     Creature *critter = g->critter_at( p, true );
     player *ph = dynamic_cast<player *>( critter );
 
-    Creature *driver = pl_ctrl ? &g->u : nullptr;
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
         ph = nullptr;
     }
 
-    const optional_vpart_position ovp = g->m.veh_at( p );
+    const optional_vpart_position ovp = may_hit_vehicles ? g->m.veh_at( p ) :
+                                        optional_vpart_position( cata::nullopt );
     // Disable vehicle/critter collisions when bashing floor
     // TODO: More elegant code
     const bool is_veh_collision = !bash_floor && ovp && &ovp->vehicle() != this;
@@ -508,6 +524,9 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         return ret;
     }
 
+    const bool pl_ctrl = player_in_control( g->u );
+    Creature *driver = pl_ctrl ? &g->u : nullptr;
+
     // Calculate mass AFTER checking for collision
     //  because it involves iterating over all cargo
     const float mass = to_kilogram( total_mass() );
@@ -648,9 +648,11 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
 
             // if necessary remove item from the luminosity map
             sub->update_lum_rem( offset, *iter );
+            sub->items_changed( offset );
 
             // finally remove the item
-            res.splice( res.end(), sub->itm[ offset.x ][ offset.y ], iter++ );
+            res.push_back( std::move( *iter ) );
+            iter = sub->itm[ offset.x ][ offset.y ].erase( iter );
 
             if( --count == 0 ) {
                 return res;
@@ -706,7 +708,8 @@ std::list<item> visitable<vehicle_cursor>::remove_items_with( const
             if( cur->veh.active_items.has( iter, part.mount ) ) {
                 cur->veh.active_items.remove( iter, part.mount );
             }
-            res.splice( res.end(), part.items, iter++ );
+            res.push_back( std::move( *iter ) );
+            iter = part.items.erase( iter );
             if( --count == 0 ) {
                 return res;
             }
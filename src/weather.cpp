@@ -104,8 +104,14 @@ time_duration get_rot_since( const time_point &start, const time_point &end,
 
     const auto temp_modify = ( !g->new_game ) && ( g->m.ter( local ) == t_rootcellar );
 
+    std::vector<time_point> hours;
     for( time_point i = start; i < end; i += 1_hours ) {
-        w_point w = wgen.get_weather( pos, i, seed );
+        hours.push_back( i );
+    }
+    const std::vector<w_point> weather = wgen.get_weather_batch( pos, hours, seed );
+    for( size_t h = 0; h < hours.size(); h++ ) {
+        const time_point &i = hours[h];
+        const w_point &w = weather[h];
 
         //Use weather if above ground, use map temp if below
         double temperature = ( pos.z >= 0 ? w.temperature : location_temp ) + local_mod;
@@ -636,8 +642,11 @@ std::string weather_forecast( const point &abs_sm_pos )
     for( int d = 0; d < 6; d++ ) {
         weather_type forecast = WEATHER_NULL;
         const auto wgen = g->get_cur_weather_gen();
+        std::vector<time_point> hours;
         for( time_point i = last_hour + d * 12_hours; i < last_hour + ( d + 1 ) * 12_hours; i += 1_hours ) {
-            w_point w = wgen.get_weather( abs_ms_pos, i, g->get_seed() );
+            hours.push_back( i );
+        }
+        for( const w_point &w : wgen.get_weather_batch( abs_ms_pos, hours, g->get_seed() ) ) {
             forecast = std::max( forecast, wgen.get_weather_conditions( w ) );
             high = std::max( high, w.temperature );
             low = std::min( low, w.temperature );
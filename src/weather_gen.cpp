@@ -1,6 +1,7 @@
 #include "weather_gen.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
@@ -21,33 +22,123 @@ namespace
 // GCC doesn't like M_PI here for some reason
 constexpr double PI  = 3.141592653589793238463;
 constexpr double tau = 2 * PI;
+
+// A point at which one of the noise functions behind the weather is sampled
+struct noise_point {
+    float x;
+    float y;
+    float z;
+    float w;
+};
 } //namespace
 
 weather_generator::weather_generator() = default;
 int weather_generator::current_winddir = 1000;
 
+// The noise get_weather samples for the weather at a location and time. The x and y position and
+// the turn are divided by a widening factor to get smooth changes. The temperature noise is
+// also used for acid rain.
+static std::array<noise_point, weather_generator::num_noises> weather_noise_points(
+    const tripoint &location, const time_point &t, unsigned seed )
+{
+    // Integer x position / widening factor of the Perlin function.
+    const double x( location.x / 2000.0 );
+    // Integer y position / widening factor of the Perlin function.
+    const double y( location.y / 2000.0 );
+    // Integer turn / widening factor of the Perlin function.
+    const double z( to_turn<int>( t + calendar::season_length() ) / 2000.0 );
+
+    //limit the random seed during noise calculation, a large value flattens the noise generator to zero
+    //Windows has a rand limit of 32768, other operating systems can have higher limits
+    const unsigned modSEED = seed % 32768;
+    const auto at = []( double px, double py, double pz, unsigned pw ) {
+        return noise_point{ static_cast<float>( px ), static_cast<float>( py ),
+                            static_cast<float>( pz ), static_cast<float>( pw ) };
+    };
+    return {{
+            at( x, y, z, modSEED ), // temperature and acid
+            at( x, y, z / 5, modSEED + 101 ), // humidity
+            at( x, y, z, modSEED + 151 ), // humidity variation
+            at( x / 2.5, y / 2.5, z / 30, modSEED + 211 ), // pressure
+            at( x / 2.5, y / 2.5, z / 200, modSEED ) // wind
+        }
+    };
+}
+
 w_point weather_generator::get_weather( const tripoint &location, const time_point &t,
                                         unsigned seed ) const
 {
-    const double x( location.x /
-                    2000.0 ); // Integer x position / widening factor of the Perlin function.
-    const double y( location.y /
-                    2000.0 ); // Integer y position / widening factor of the Perlin function.
-    const double z( to_turn<int>( t + calendar::season_length() ) /
-                    2000.0 ); // Integer turn / widening factor of the Perlin function.
+    std::array<float, num_noises> noise;
+    const auto points = weather_noise_points( location, t, seed );
+    for( size_t i = 0; i < num_noises; i++ ) {
+        noise[i] = raw_noise_4d( points[i].x, points[i].y, points[i].z, points[i].w );
+    }
+    return weather_from_noise( t, seed, noise );
+}
+
+std::vector<w_point> weather_generator::get_weather_batch( const tripoint &location,
+        const std::vector<time_point> &times, unsigned seed ) const
+{
+    return get_weather_batch( std::vector<tripoint>( times.size(), location ), times, seed );
+}
 
+std::vector<w_point> weather_generator::get_weather_batch( const std::vector<tripoint> &locations,
+        const time_point &t, unsigned seed ) const
+{
+    return get_weather_batch( locations, std::vector<time_point>( locations.size(), t ), seed );
+}
+
+std::vector<w_point> weather_generator::get_weather_batch( const std::vector<tripoint> &locations,
+        const std::vector<time_point> &times, unsigned seed ) const
+{
+    const size_t count = times.size();
+    // The coordinates for each noise function, one array per axis, and its results
+    std::vector<float> coords[num_noises][4];
+    std::vector<float> noise[num_noises];
+    for( size_t i = 0; i < num_noises; i++ ) {
+        for( std::vector<float> &axis : coords[i] ) {
+            axis.resize( count );
+        }
+        noise[i].resize( count );
+    }
+    for( size_t n = 0; n < count; n++ ) {
+        const auto points = weather_noise_points( locations[n], times[n], seed );
+        for( size_t i = 0; i < num_noises; i++ ) {
+            coords[i][0][n] = points[i].x;
+            coords[i][1][n] = points[i].y;
+            coords[i][2][n] = points[i].z;
+            coords[i][3][n] = points[i].w;
+        }
+    }
+    for( size_t i = 0; i < num_noises; i++ ) {
+        raw_noise_4d_batch( coords[i][0].data(), coords[i][1].data(), coords[i][2].data(),
+                            coords[i][3].data(), noise[i].data(), count );
+    }
+
+    std::vector<w_point> result;
+    result.reserve( count );
+    for( size_t n = 0; n < count; n++ ) {
+        std::array<float, num_noises> sample;
+        for( size_t i = 0; i < num_noises; i++ ) {
+            sample[i] = noise[i][n];
+        }
+        result.push_back( weather_from_noise( times[n], seed, sample ) );
+    }
+    return result;
+}
+
+w_point weather_generator::weather_from_noise( const time_point &t, unsigned seed,
+        const std::array<float, num_noises> &noise ) const
+{
     const double dayFraction = time_past_midnight( t ) / 1_days;
 
-    //limit the random seed during noise calculation, a large value flattens the noise generator to zero
-    //Windows has a rand limit of 32768, other operating systems can have higher limits
-    const unsigned modSEED = seed % 32768;
     // Noise factors
-    double T( raw_noise_4d( x, y, z, modSEED ) * 4.0 );
-    double H( raw_noise_4d( x, y, z / 5, modSEED + 101 ) );
-    double H2( raw_noise_4d( x, y, z, modSEED + 151 ) / 4 );
-    double P( raw_noise_4d( x / 2.5, y / 2.5, z / 30, modSEED + 211 ) * 70 );
-    double A( raw_noise_4d( x, y, z, modSEED ) * 8.0 );
-    double W( raw_noise_4d( x / 2.5, y / 2.5, z / 200, modSEED ) * 10.0 );
+    double T( noise[0] * 4.0 );
+    double H( noise[1] );
+    double H2( noise[2] / 4 );
+    double P( noise[3] * 70 );
+    double A( noise[0] * 8.0 );
+    double W( noise[4] * 10.0 );
 
     const double now( ( time_past_new_year( t ) + calendar::season_length() / 2 ) /
                       calendar::year_length() ); // [0,1)
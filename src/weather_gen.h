@@ -2,6 +2,10 @@
 #ifndef WEATHER_GEN_H
 #define WEATHER_GEN_H
 
+#include <array>
+#include <string>
+#include <vector>
+
 #include "calendar.h"
 struct point;
 struct tripoint;
@@ -40,6 +44,14 @@ class weather_generator
          * relative position (relative to the map you called getabs on).
          */
         w_point get_weather( const tripoint &, const time_point &, unsigned ) const;
+        /**
+         * Same as calling @ref get_weather for each of the times (or locations) in turn, but the
+         * noise behind the weather is calculated for all of them at once, which is a lot faster.
+         */
+        std::vector<w_point> get_weather_batch( const tripoint &, const std::vector<time_point> &,
+                                                unsigned seed ) const;
+        std::vector<w_point> get_weather_batch( const std::vector<tripoint> &, const time_point &,
+                                                unsigned seed ) const;
         weather_type get_weather_conditions( const tripoint &, const time_point &, unsigned seed ) const;
         weather_type get_weather_conditions( const w_point & ) const;
         int get_wind_direction( const season_type, unsigned seed ) const;
@@ -49,6 +61,16 @@ class weather_generator
         void test_weather() const;
 
         static weather_generator load( JsonObject &jo );
+
+        /** Number of noise functions the weather is made of */
+        static constexpr size_t num_noises = 5;
+
+    private:
+        std::vector<w_point> get_weather_batch( const std::vector<tripoint> &,
+                                                const std::vector<time_point> &,
+                                                unsigned seed ) const;
+        w_point weather_from_noise( const time_point &, unsigned seed,
+                                    const std::array<float, num_noises> &noise ) const;
 };
 
 #endif
@@ -418,7 +418,7 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
 
             for( i = 0; i < win->width; i++ ) {
                 const cursecell &cell = win->line[j].chars[i];
-                if( cell.ch.empty() ) {
+                if( cell.empty() ) {
                     continue; // second cell of a multi-cell character
                 }
                 drawx = ( ( win->x + i ) * fontwidth );
@@ -431,13 +431,12 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                 int FG = cell.FG;
                 int BG = cell.BG;
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, BG );
-                static const std::string space_string = " ";
                 // Spaces don't need any drawing except background
-                if( cell.ch == space_string ) {
+                if( cell.is_space() ) {
                     continue;
                 }
 
-                tmp = UTF8_getch( cell.ch );
+                tmp = cell.codepoint;
                 if( tmp != UNKNOWN_UNICODE ) {
 
                     int color = RGB( windowsPalette[FG].rgbRed, windowsPalette[FG].rgbGreen,
@@ -450,11 +449,11 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                         i += cw - 1;
                     }
                     if( tmp ) {
-                        const std::wstring utf16 = widen( cell.ch );
+                        const std::wstring utf16 = widen( cell.str() );
                         ExtTextOutW( backbuffer, drawx, drawy, 0, NULL, utf16.c_str(), utf16.length(), NULL );
                     }
                 } else {
-                    switch( ( unsigned char )win->line[j].chars[i].ch[0] ) {
+                    switch( ( unsigned char )cell.bytes[0] ) {
                         // box bottom/top side (horizontal line)
                         case LINE_OXOX_C:
                             HorzLineDIB( drawx, drawy + halfheight, drawx + fontwidth, 1, FG );
@@ -0,0 +1,62 @@
+#include <map>
+
+#include "catch/catch.hpp"
+#include "active_item_cache.h"
+#include "item.h"
+#include "item_arena.h"
+
+TEST_CASE( "active_item_cache_round_robin", "[active_item]" )
+{
+    item_list items;
+    active_item_cache cache;
+    const point location( 3, 4 );
+    const int food_count = 250;
+    for( int i = 0; i < food_count; ++i ) {
+        items.emplace_back( "meat_cooked" );
+        cache.add( std::prev( items.end() ), location );
+    }
+    items.emplace_back( "lighter" );
+    const auto tool = std::prev( items.end() );
+    cache.add( tool, location );
+    REQUIRE( tool->processing_speed() == 1 );
+    REQUIRE( items.front().processing_speed() == 100 );
+
+    std::map<item *, int> times_processed;
+    const int turns = 83;
+    for( int turn = 0; turn < turns; ++turn ) {
+        const std::vector<item_reference> batch = cache.get();
+        for( const item_reference &ref : batch ) {
+            REQUIRE( cache.has( ref ) );
+            times_processed[&*ref.item_iterator]++;
+            // Mimic map processing, which takes the item out and puts it back.
+            cache.remove( ref.item_iterator, ref.location );
+            cache.add( ref.item_iterator, ref.location );
+        }
+    }
+
+    CHECK( times_processed[&*tool] == turns );
+    int processed_once = 0;
+    for( auto it = items.begin(); it != tool; ++it ) {
+        if( times_processed[&*it] == 1 ) {
+            processed_once++;
+        }
+    }
+    // 3 food items per turn, so every item gets its turn before any gets a second one.
+    CHECK( processed_once == food_count - 1 );
+
+    SECTION( "removed items are not processed" ) {
+        cache.remove( tool, location );
+        for( const item_reference &ref : cache.get() ) {
+            CHECK( ref.item_iterator != tool );
+        }
+        CHECK( cache.get_all().size() == static_cast<size_t>( food_count ) );
+    }
+
+    SECTION( "cache empties" ) {
+        for( auto it = items.begin(); it != items.end(); ++it ) {
+            cache.remove( it, location );
+        }
+        CHECK( cache.empty() );
+        CHECK( cache.get().empty() );
+    }
+}
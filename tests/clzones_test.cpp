@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <unordered_set>
+#include <vector>
+
+#include "activity_handlers.h"
+#include "catch/catch.hpp"
+#include "clzones.h"
+#include "enums.h"
+#include "game.h"
+#include "item.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "optional.h"
+#include "player.h"
+#include "player_activity.h"
+#include "rng.h"
+
+static const zone_type_id zone_food( "LOOT_FOOD" );
+static const zone_type_id zone_tools( "LOOT_TOOLS" );
+
+// Squares of enabled zones of the type near where, the way they were found before the index.
+static std::unordered_set<tripoint> near_by_scanning( const zone_manager &mgr,
+        const zone_type_id &type, const tripoint &where, const int radius )
+{
+    std::unordered_set<tripoint> result;
+    for( const zone_data &zone : mgr.get_zones() ) {
+        if( zone.get_type() != type || !zone.get_enabled() ) {
+            continue;
+        }
+        for( int x = zone.get_start_point().x; x <= zone.get_end_point().x; x++ ) {
+            for( int y = zone.get_start_point().y; y <= zone.get_end_point().y; y++ ) {
+                const tripoint p( x, y, where.z );
+                if( zone.has_inside( p ) && square_dist( p, where ) <= radius ) {
+                    result.insert( p );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "zone_index_matches_the_zones", "[zones]" )
+{
+    zone_manager mgr;
+    // Overlapping, spanning several index cells, on negative coordinates and several z-levels
+    mgr.add( "pantry", zone_food, false, true, tripoint( -40, -5, 0 ), tripoint( 3, 2, 0 ) );
+    mgr.add( "cellar", zone_food, false, true, tripoint( -2, -2, -1 ), tripoint( 2, 9, 1 ) );
+    mgr.add( "shed", zone_tools, false, true, tripoint( 30, 30, 0 ), tripoint( 31, 100, 0 ) );
+    mgr.add( "disabled", zone_tools, false, false, tripoint( 0, 0, 0 ), tripoint( 5, 5, 0 ) );
+    const int radius = 10;
+
+    for( int z = -1; z <= 1; z++ ) {
+        for( int x = -60; x <= 60; x += 7 ) {
+            for( int y = -20; y <= 110; y += 9 ) {
+                const tripoint where( x, y, z );
+                for( const zone_type_id &type : {
+                         zone_food, zone_tools
+                     } ) {
+                    const std::unordered_set<tripoint> expected =
+                        near_by_scanning( mgr, type, where, radius );
+                    CAPTURE( where );
+                    CHECK( mgr.get_near( type, where ) == expected );
+                    CHECK( mgr.has_near( type, where ) == !expected.empty() );
+                    bool inside = false;
+                    for( const zone_data &zone : mgr.get_zones() ) {
+                        inside |= zone.get_type() == type && zone.get_enabled() &&
+                                  zone.has_inside( where );
+                    }
+                    CHECK( mgr.has( type, where ) == inside );
+                    const cata::optional<tripoint> nearest = mgr.get_nearest( type, where );
+                    CHECK( static_cast<bool>( nearest ) == !expected.empty() );
+                    if( nearest ) {
+                        CHECK( expected.count( *nearest ) == 1 );
+                        int closest = INT_MAX;
+                        for( const tripoint &p : expected ) {
+                            closest = std::min( closest, square_dist( where, p ) );
+                        }
+                        CHECK( square_dist( where, *nearest ) == closest );
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "zone_index_perf", "[.]" )
+{
+    zone_manager mgr;
+    const std::vector<zone_type_id> types = {
+        zone_type_id( "LOOT_UNSORTED" ), zone_food, zone_tools, zone_type_id( "LOOT_AMMO" ),
+        zone_type_id( "LOOT_CLOTHING" ), zone_type_id( "LOOT_WOOD" )
+    };
+    // A big base: dozens of large zones, three levels high
+    const int num_zones = 48;
+    for( int i = 0; i < num_zones; i++ ) {
+        const tripoint start( rng( -200, 200 ), rng( -200, 200 ), -1 );
+        mgr.add( "zone", types[i % types.size()], false, true, start,
+                 start + tripoint( rng( 20, 100 ), rng( 20, 100 ), 2 ) );
+    }
+
+    const int rebuilds = 100;
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < rebuilds; i++ ) {
+        mgr.cache_data();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    long elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "%d zones: %ld microseconds per rebuild.\n", num_zones, elapsed / rebuilds );
+
+    const int queries = 10000;
+    int found = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < queries; i++ ) {
+        const tripoint where( rng( -250, 250 ), rng( -250, 250 ), 0 );
+        const zone_type_id &type = types[i % types.size()];
+        if( mgr.has_near( type, where ) ) {
+            found += mgr.get_near( type, where ).size();
+        }
+        found += mgr.has( type, where ) ? 1 : 0;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "%d zone queries in %ld microseconds (%d squares found).\n", queries, elapsed, found );
+}
+
+TEST_CASE( "loot_sorting_puts_items_in_their_zones", "[zones][activity]" )
+{
+    clear_map();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    const tripoint unsorted( 61, 60, 0 );
+    const tripoint pantry( 64, 60, 0 );
+    const tripoint shed( 60, 64, 0 );
+
+    zone_manager &mgr = zone_manager::get_manager();
+    const unsigned int zones_before = mgr.size();
+    mgr.add( "unsorted", zone_type_id( "LOOT_UNSORTED" ), false, true, g->m.getabs( unsorted ),
+             g->m.getabs( unsorted ) );
+    mgr.add( "pantry", zone_food, false, true, g->m.getabs( pantry ),
+             g->m.getabs( pantry + tripoint( 1, 0, 0 ) ) );
+    mgr.add( "shed", zone_tools, false, true, g->m.getabs( shed ), g->m.getabs( shed ) );
+    // clear_map leaves items behind
+    for( const tripoint &p : {
+             unsorted, pantry, pantry + tripoint( 1, 0, 0 ), shed
+         } ) {
+        g->m.i_clear( p );
+    }
+
+    for( int i = 0; i < 3; i++ ) {
+        g->m.add_item( unsorted, item( "apple" ) );
+        g->m.add_item( unsorted, item( "hammer" ) );
+    }
+
+    // Several rounds, each of them moving a few items before running out of moves
+    player_activity act( activity_id( "ACT_MOVE_LOOT" ) );
+    for( int turn = 0; turn < 100 && !g->m.i_at( unsorted ).empty(); turn++ ) {
+        g->u.moves = 100;
+        activity_on_turn_move_loot( act, g->u );
+        if( !g->u.activity ) {
+            break;
+        }
+    }
+
+    CHECK( g->m.i_at( unsorted ).empty() );
+    int apples = 0;
+    for( const tripoint &p : {
+             pantry, pantry + tripoint( 1, 0, 0 )
+         } ) {
+        for( const item &it : g->m.i_at( p ) ) {
+            CHECK( it.typeId() == "apple" );
+            // Food stacks up by charges
+            apples += it.count_by_charges() ? it.charges : 1;
+        }
+    }
+    CHECK( apples == 3 );
+    CHECK( g->m.i_at( shed ).size() == 3 );
+    for( const item &it : g->m.i_at( shed ) ) {
+        CHECK( it.typeId() == "hammer" );
+    }
+    for( const tripoint &p : {
+             unsorted, pantry, pantry + tripoint( 1, 0, 0 ), shed
+         } ) {
+        g->m.i_clear( p );
+    }
+
+    // Zones are added at the end, so the ones from this test are the last three
+    while( mgr.size() > zones_before ) {
+        mgr.remove( mgr.get_zones().back().get() );
+    }
+    mgr.cache_data();
+}
+
+TEST_CASE( "loot_sorting_notices_containers_emptied_in_place", "[zones][activity]" )
+{
+    clear_map();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    const tripoint unsorted( 61, 60, 0 );
+    const tripoint cupboard( 64, 60, 0 );
+
+    // No food zone, so the full jar has nowhere to go
+    zone_manager &mgr = zone_manager::get_manager();
+    const unsigned int zones_before = mgr.size();
+    mgr.add( "unsorted", zone_type_id( "LOOT_UNSORTED" ), false, true, g->m.getabs( unsorted ),
+             g->m.getabs( unsorted ) );
+    mgr.add( "cupboard", zone_type_id( "LOOT_OTHER" ), false, true, g->m.getabs( cupboard ),
+             g->m.getabs( cupboard ) );
+    g->m.i_clear( unsorted );
+    g->m.i_clear( cupboard );
+
+    item jar( "jar_glass" );
+    jar.put_in( item( "apple" ) );
+    g->m.add_item( unsorted, jar );
+
+    const auto sort_loot = []() {
+        player_activity act( activity_id( "ACT_MOVE_LOOT" ) );
+        for( int turn = 0; turn < 10; turn++ ) {
+            g->u.moves = 100;
+            activity_on_turn_move_loot( act, g->u );
+            if( !g->u.activity ) {
+                break;
+            }
+        }
+    };
+    sort_loot();
+    REQUIRE( g->m.i_at( unsorted ).size() == 1 );
+    CHECK( g->m.i_at( cupboard ).empty() );
+
+    // Emptying the jar doesn't add or remove anything on the square
+    const uint64_t stamp = g->m.item_stamp( unsorted );
+    g->m.i_at( unsorted ).front().contents.clear();
+    REQUIRE( g->m.item_stamp( unsorted ) == stamp );
+    sort_loot();
+    CHECK( g->m.i_at( unsorted ).empty() );
+    REQUIRE( g->m.i_at( cupboard ).size() == 1 );
+    CHECK( g->m.i_at( cupboard ).front().typeId() == "jar_glass" );
+    g->m.i_clear( unsorted );
+    g->m.i_clear( cupboard );
+
+    while( mgr.size() > zones_before ) {
+        mgr.remove( mgr.get_zones().back().get() );
+    }
+    mgr.cache_data();
+}
@@ -2,6 +2,7 @@
 
 #include "catch/catch.hpp"
 #include "enums.h"
+#include "explosion.h"
 #include "game.h"
 #include "item.h"
 #include "itype.h"
@@ -125,3 +126,23 @@ TEST_CASE( "grenade_vs_vehicle", "[grenade],[explosion],[balance]" )
 {
     check_vehicle_damage( "grenade_act", "car", 5 );
 }
+
+TEST_CASE( "batched_explosions_go_off_together", "[explosion]" )
+{
+    clear_map_and_put_player_underground();
+    const tripoint origin( 30, 30, 0 );
+    monster &near = spawn_test_monster( "mon_zombie", origin + tripoint( 2, 0, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", origin + tripoint( -2, 0, 0 ) );
+    const int near_hp = near.get_hp();
+    const int far_hp = far.get_hp();
+    {
+        explosion_batch batch;
+        g->explosion( origin + tripoint( 1, 0, 0 ), 20, 0.5, false, 50 );
+        g->explosion( origin + tripoint( -1, 0, 0 ), 20, 0.5, false, 50 );
+        // Nothing happens until the batch ends
+        CHECK( near.get_hp() == near_hp );
+        CHECK( far.get_hp() == far_hp );
+    }
+    CHECK( near.get_hp() < near_hp );
+    CHECK( far.get_hp() < far_hp );
+}
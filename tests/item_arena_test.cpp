@@ -0,0 +1,180 @@
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "item.h"
+#include "item_arena.h"
+#include "item_category.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_selector.h"
+#include "mapbuffer.h"
+#include "submap.h"
+
+TEST_CASE( "item_arena_reuses_and_releases_nodes", "[item][arena]" )
+{
+    item_arena arena;
+    const arena_allocator<item> alloc( &arena );
+    item_list items( alloc );
+    for( int i = 0; i < 100; ++i ) {
+        items.emplace_back( "rock" );
+    }
+    CHECK( arena.size() == 100 );
+
+    // References to items survive other items coming and going
+    item &kept = items.front();
+    item *const kept_address = &kept;
+    items.pop_back();
+    items.emplace_back( "2x4" );
+    CHECK( &items.front() == kept_address );
+    CHECK( arena.size() == 100 );
+
+    SECTION( "copies don't use the arena" ) {
+        item_list copy( items );
+        CHECK( copy.get_allocator().arena == nullptr );
+        CHECK( arena.size() == 100 );
+    }
+
+    SECTION( "removing all items empties the arena" ) {
+        items.clear();
+        CHECK( arena.size() == 0 );
+        items.emplace_back( "rock" );
+        CHECK( arena.size() == 1 );
+    }
+}
+
+TEST_CASE( "map_items_live_in_the_submap_arena", "[item][arena]" )
+{
+    const tripoint pos( 60, 60, 0 );
+    g->m.i_clear( pos );
+    const point offset( pos.x % SEEX, pos.y % SEEY );
+    const tripoint abs_sub = g->m.get_abs_sub();
+    submap *const sm = MAPBUFFER.lookup_submap( tripoint( abs_sub.x + pos.x / SEEX,
+                       abs_sub.y + pos.y / SEEY, pos.z ) );
+    REQUIRE( sm != nullptr );
+    const size_t nodes_before = sm->item_nodes.size();
+
+    g->m.add_item( pos, item( "rock" ) );
+    g->m.add_item( pos, item( "2x4" ) );
+    REQUIRE( sm->itm[offset.x][offset.y].size() == 2 );
+    CHECK( sm->itm[offset.x][offset.y].get_allocator().arena == &sm->item_nodes );
+    CHECK( sm->item_nodes.size() == nodes_before + 2 );
+
+    const std::list<item> taken = map_cursor( pos ).remove_items_with( []( const item & ) {
+        return true;
+    } );
+    CHECK( taken.size() == 2 );
+    CHECK( g->m.i_at( pos ).empty() );
+    CHECK( sm->item_nodes.size() == nodes_before );
+}
+
+// Benchmarks of the common ways of walking big piles of items.
+
+static const std::vector<std::string> warehouse_stock = {
+    "rock", "2x4", "jeans", "hammer", "can_beans", "pipe", "tshirt", "scrap"
+};
+static constexpr int warehouse_size = 24;
+static constexpr int items_per_tile = 40;
+static const tripoint warehouse_corner( 30, 30, 0 );
+
+static void fill_warehouse()
+{
+    clear_map();
+    for( int x = 0; x < warehouse_size; ++x ) {
+        for( int y = 0; y < warehouse_size; ++y ) {
+            const tripoint p = warehouse_corner + tripoint( x, y, 0 );
+            g->m.i_clear( p );
+            for( int i = 0; i < items_per_tile; ++i ) {
+                g->m.add_item( p, item( warehouse_stock[( x + y + i ) % warehouse_stock.size()] ) );
+            }
+        }
+    }
+}
+
+template<typename F>
+static long time_warehouse( F func )
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int x = 0; x < warehouse_size; ++x ) {
+        for( int y = 0; y < warehouse_size; ++y ) {
+            func( warehouse_corner + tripoint( x, y, 0 ) );
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+}
+
+TEST_CASE( "warehouse_pickup_perf", "[.]" )
+{
+    fill_warehouse();
+    std::list<item> picked_up;
+    const long pickup = time_warehouse( [&picked_up]( const tripoint & p ) {
+        std::list<item> here = map_cursor( p ).remove_items_with( []( const item & ) {
+            return true;
+        } );
+        picked_up.splice( picked_up.end(), here );
+    } );
+    const long drop = time_warehouse( [&picked_up]( const tripoint & p ) {
+        for( int i = 0; i < items_per_tile && !picked_up.empty(); ++i ) {
+            g->m.add_item( p, picked_up.front() );
+            picked_up.pop_front();
+        }
+    } );
+    printf( "picked up %d items in %ld microseconds, dropped them in %ld microseconds.\n",
+            warehouse_size * warehouse_size * items_per_tile, pickup, drop );
+}
+
+TEST_CASE( "warehouse_advanced_inventory_listing_perf", "[.]" )
+{
+    fill_warehouse();
+    // What advanced inventory does for each square: group the items into stacks and sum them up.
+    int stacks = 0;
+    const long listing = time_warehouse( [&stacks]( const tripoint & p ) {
+        std::vector<std::pair<const item *, int>> entries;
+        units::volume volume = 0_ml;
+        units::mass weight = 0_gram;
+        for( const item &it : g->m.i_at( p ) ) {
+            volume += it.volume();
+            weight += it.weight();
+            auto iter = entries.begin();
+            while( iter != entries.end() && !iter->first->stacks_with( it ) ) {
+                ++iter;
+            }
+            if( iter == entries.end() ) {
+                entries.emplace_back( &it, 1 );
+            } else {
+                iter->second++;
+            }
+        }
+        stacks += entries.size();
+    } );
+    printf( "listed %d stacks in %ld microseconds.\n", stacks, listing );
+}
+
+TEST_CASE( "warehouse_zone_sorting_perf", "[.]" )
+{
+    fill_warehouse();
+    // Sort every item onto a pile for its category, like hauling loot into zones.
+    std::map<std::string, tripoint> destinations;
+    const tripoint sorted_corner = warehouse_corner + tripoint( 0, warehouse_size + 2, 0 );
+    const long sorting = time_warehouse( [&destinations, &sorted_corner]( const tripoint & p ) {
+        auto items = g->m.i_at( p );
+        for( auto it = items.begin(); it != items.end(); ) {
+            const std::string category = it->get_category().id();
+            auto dest = destinations.find( category );
+            if( dest == destinations.end() ) {
+                const tripoint pile = sorted_corner + tripoint( static_cast<int>( destinations.size() ), 0, 0 );
+                dest = destinations.emplace( category, pile ).first;
+            }
+            g->m.add_item( dest->second, *it );
+            it = items.erase( it );
+        }
+    } );
+    printf( "sorted %d items into %d piles in %ld microseconds.\n",
+            warehouse_size * warehouse_size * items_per_tile,
+            static_cast<int>( destinations.size() ), sorting );
+}
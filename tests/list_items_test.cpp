@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_item_stack.h"
+#include "player.h"
+
+static void light_up_map()
+{
+    calendar::turn = HOURS( 12 );
+    g->reset_light_level();
+    g->m.update_visibility_cache( g->u.posz() );
+    g->m.build_map_cache( g->u.posz() );
+}
+
+// The item listing the way it was built before, one name lookup per item.
+static std::vector<map_item_stack> list_by_name( const int radius )
+{
+    std::map<std::string, map_item_stack> temp_items;
+    std::vector<std::string> item_order;
+    for( const tripoint &p : closest_tripoints_first( radius, g->u.pos() ) ) {
+        if( !g->u.sees( p ) || !g->m.sees_some_items( p, g->u ) ) {
+            continue;
+        }
+        for( const item &it : g->m.i_at( p ) ) {
+            const std::string name = it.tname();
+            if( std::find( item_order.begin(), item_order.end(), name ) == item_order.end() ) {
+                item_order.push_back( name );
+                temp_items[name] = map_item_stack( &it, p - g->u.pos() );
+            } else {
+                temp_items[name].add_at_pos( &it, p - g->u.pos() );
+            }
+        }
+    }
+    std::vector<map_item_stack> ret;
+    for( const std::string &name : item_order ) {
+        ret.push_back( temp_items[name] );
+    }
+    return ret;
+}
+
+TEST_CASE( "nearby_items_are_grouped_by_name", "[items][list]" )
+{
+    clear_map();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    light_up_map();
+    const int radius = 10;
+    // clear_map leaves items behind
+    for( const tripoint &p : closest_tripoints_first( radius, g->u.pos() ) ) {
+        g->m.i_clear( p );
+    }
+
+    item damaged_hammer( "hammer" );
+    damaged_hammer.mod_damage( 2000 );
+    item wet_rag( "rag" );
+    wet_rag.set_flag( "WET" );
+    for( int i = 0; i < 12; i++ ) {
+        const tripoint p( 55 + i % 5, 57 + i / 5, 0 );
+        g->m.add_item( p, item( "hammer" ) );
+        g->m.add_item( p, item( "9mm", calendar::turn, 10 + i ) );
+        g->m.add_item( p, item( "apple" ) );
+        g->m.add_item( p, item( "rag" ) );
+        if( i % 3 == 0 ) {
+            g->m.add_item( p, damaged_hammer );
+            g->m.add_item( p, wet_rag );
+        }
+    }
+
+    const std::vector<map_item_stack> expected = list_by_name( radius );
+    const std::vector<map_item_stack> listed = g->find_nearby_items( radius );
+    REQUIRE( expected.size() == 6 );
+    REQUIRE( listed.size() == expected.size() );
+    for( size_t i = 0; i < listed.size(); i++ ) {
+        CAPTURE( expected[i].example->tname() );
+        CHECK( listed[i].example->tname() == expected[i].example->tname() );
+        CHECK( listed[i].totalcount == expected[i].totalcount );
+        REQUIRE( listed[i].vIG.size() == expected[i].vIG.size() );
+        for( size_t j = 0; j < listed[i].vIG.size(); j++ ) {
+            CHECK( listed[i].vIG[j].pos == expected[i].vIG[j].pos );
+            CHECK( listed[i].vIG[j].count == expected[i].vIG[j].count );
+        }
+    }
+}
+
+TEST_CASE( "nearby_items_perf", "[.]" )
+{
+    clear_map();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    light_up_map();
+
+    // A warehouse: 10000 items of a few dozen kinds, piled up all around
+    const std::vector<std::string> kinds = {
+        "hammer", "rag", "wrench", "apple", "9mm", "rock"
+    };
+    const int num_items = 10000;
+    for( int i = 0; i < num_items; i++ ) {
+        const tripoint p( 40 + i % 41, 40 + ( i / 41 ) % 41, 0 );
+        item it( kinds[i % kinds.size()] );
+        if( i % 7 == 0 ) {
+            it.mod_damage( 1000 * ( i % 4 ) );
+        }
+        g->m.add_item( p, it );
+    }
+
+    const int radius = 30;
+    const int repeats = 10;
+    size_t stacks = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < repeats; i++ ) {
+        stacks = g->find_nearby_items( radius ).size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    long elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "%d items in %d stacks: %ld microseconds per listing.\n", num_items,
+            static_cast<int>( stacks ), elapsed / repeats );
+
+    start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < repeats; i++ ) {
+        stacks = list_by_name( radius ).size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "%d items in %d stacks: %ld microseconds per listing by name.\n", num_items,
+            static_cast<int>( stacks ), elapsed / repeats );
+}
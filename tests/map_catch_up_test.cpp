@@ -0,0 +1,115 @@
+#include "catch/catch.hpp"
+#include "calendar.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "submap.h"
+
+// Submaps outside of the reality bubble are caught up in one step when they are loaded again.
+// That has to end up close to what processing them the whole time would have done.
+
+static void check_rot_catch_up( const tripoint &pos )
+{
+    const time_point old_turn = calendar::turn;
+    // Items spawned at game start get a random head start on rotting, avoid that.
+    const time_point start = calendar::start + 1_days;
+    calendar::turn = to_turn<int>( start );
+    item caught_up( "meat_cooked" );
+    item processed( "meat_cooked" );
+    caught_up.calc_rot( pos );
+    processed.calc_rot( pos );
+
+    const time_duration step = 10_minutes;
+    const time_duration elapsed = 2_days;
+    for( time_duration t = 0_turns; t < elapsed; t += step ) {
+        calendar::turn = to_turn<int>( start + t + step );
+        processed.calc_rot( pos );
+    }
+    caught_up.calc_rot( pos );
+
+    INFO( "processed: " << to_turns<int>( processed.get_rot() ) <<
+          " caught up: " << to_turns<int>( caught_up.get_rot() ) );
+    CHECK( caught_up.get_rot() > 0_turns );
+    CHECK( to_turns<double>( caught_up.get_rot() ) ==
+           Approx( to_turns<double>( processed.get_rot() ) ).epsilon( 0.1 ) );
+
+    calendar::turn = to_turn<int>( old_turn );
+}
+
+TEST_CASE( "rot_catch_up_matches_processing", "[catch_up]" )
+{
+    SECTION( "underground" ) {
+        check_rot_catch_up( tripoint( 60, 60, -1 ) );
+    }
+    SECTION( "outside" ) {
+        check_rot_catch_up( tripoint( 60, 60, 0 ) );
+    }
+}
+
+TEST_CASE( "rot_catch_up_on_reloaded_submap_matches_processing", "[catch_up]" )
+{
+    const time_point old_turn = calendar::turn;
+    calendar::turn = to_turn<int>( calendar::start + 1_days );
+    // Somewhere away from the player, underground so the food doesn't freeze on the map
+    const tripoint where( g->get_levx() + 20, g->get_levy() + 20, -1 );
+    const tripoint food_pos( 5, 5, -1 );
+    tinymap m;
+    m.load( where.x, where.y, where.z, false );
+    m.ter_set( food_pos, ter_id( "t_rock_floor" ) );
+    m.i_clear( food_pos );
+    m.add_item( food_pos, item( "meat_cooked" ) );
+    REQUIRE( m.i_at( food_pos ).size() == 1 );
+    const tripoint abs_pos = m.getabs( food_pos );
+    item processed( "meat_cooked" );
+    processed.calc_rot( abs_pos );
+
+    // The submap is left alone while the other item is processed every 10 minutes
+    const time_point start = calendar::turn;
+    const time_duration step = 10_minutes;
+    const time_duration elapsed = 2_days;
+    for( time_duration t = 0_turns; t < elapsed; t += step ) {
+        calendar::turn = to_turn<int>( start + t + step );
+        processed.calc_rot( abs_pos );
+    }
+    m.load( where.x, where.y, where.z, false );
+
+    auto items = m.i_at( food_pos );
+    REQUIRE( items.size() == 1 );
+    const item &caught_up = items.front();
+    INFO( "processed: " << to_turns<int>( processed.get_rot() ) <<
+          " caught up: " << to_turns<int>( caught_up.get_rot() ) );
+    CHECK( caught_up.get_rot() > 0_turns );
+    CHECK( to_turns<double>( caught_up.get_rot() ) ==
+           Approx( to_turns<double>( processed.get_rot() ) ).epsilon( 0.1 ) );
+
+    m.i_clear( food_pos );
+    calendar::turn = to_turn<int>( old_turn );
+}
+
+TEST_CASE( "fires_burn_out_outside_reality_bubble", "[catch_up]" )
+{
+    // Somewhere away from the player
+    const tripoint where( g->get_levx() + 20, g->get_levy() + 20, 0 );
+    tinymap m;
+    m.load( where.x, where.y, where.z, false );
+    const tripoint fire_pos( 5, 5, 0 );
+    m.add_field( fire_pos, fd_fire, 3 );
+    submap *sm = MAPBUFFER.lookup_submap( where );
+    REQUIRE( sm != nullptr );
+
+    SECTION( "a short absence barely changes the fire" ) {
+        sm->last_touched = calendar::turn - 10_minutes;
+        m.load( where.x, where.y, where.z, false );
+        CHECK( m.get_field_strength( fire_pos, fd_fire ) == 3 );
+    }
+
+    SECTION( "a long absence burns the fire out" ) {
+        sm->last_touched = calendar::turn - 6_hours;
+        m.load( where.x, where.y, where.z, false );
+        CHECK( m.get_field_strength( fire_pos, fd_fire ) == 0 );
+    }
+
+    m.remove_field( fire_pos, fd_fire );
+}
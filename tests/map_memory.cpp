@@ -5,9 +5,12 @@
 #include "json.h"
 #include "game_constants.h"
 
+// Each of these is in a different chunk of the memory.
 static constexpr tripoint p1{ 0, 0, 1 };
 static constexpr tripoint p2{ 0, 0, 2 };
 static constexpr tripoint p3{ 0, 0, 3 };
+// Memory limit (in tiles) that holds two chunks.
+static constexpr int two_chunks = 2 * SEEX * SEEY;
 
 TEST_CASE( "map_memory_defaults", "[map_memory]" )
 {
@@ -22,48 +25,65 @@ TEST_CASE( "map_memory_defaults", "[map_memory]" )
 TEST_CASE( "map_memory_remembers", "[map_memory]" )
 {
     map_memory memory;
-    memory.memorize_symbol( 2, p1, 1 );
-    memory.memorize_symbol( 2, p2, 2 );
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p2, 2 );
     CHECK( memory.get_symbol( p1 ) == 1 );
     CHECK( memory.get_symbol( p2 ) == 2 );
 }
 
 TEST_CASE( "map_memory_limited", "[map_memory]" )
 {
-    lru_cache<long> symbol_cache;
-    symbol_cache.insert( 2, p1, 1 );
-    symbol_cache.insert( 2, p2, 1 );
-    symbol_cache.insert( 2, p3, 1 );
-    CHECK( symbol_cache.get( p1, 0 ) == 0 );
+    map_memory memory;
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p2, 1 );
+    memory.memorize_symbol( two_chunks, p3, 1 );
+    CHECK( memory.get_symbol( p1 ) == 0 );
+    CHECK( memory.chunk_count() == 2 );
 }
 
 TEST_CASE( "map_memory_overwrites", "[map_memory]" )
 {
     map_memory memory;
-    memory.memorize_symbol( 2, p1, 1 );
-    memory.memorize_symbol( 2, p2, 2 );
-    memory.memorize_symbol( 2, p2, 3 );
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p2, 2 );
+    memory.memorize_symbol( two_chunks, p2, 3 );
     CHECK( memory.get_symbol( p1 ) == 1 );
     CHECK( memory.get_symbol( p2 ) == 3 );
 }
 
 TEST_CASE( "map_memory_erases_lru", "[map_memory]" )
 {
-    lru_cache<long> symbol_cache;
-    symbol_cache.insert( 2, p1, 1 );
-    symbol_cache.insert( 2, p2, 2 );
-    symbol_cache.insert( 2, p1, 1 );
-    symbol_cache.insert( 2, p3, 3 );
-    CHECK( symbol_cache.get( p1, 0 ) == 1 );
-    CHECK( symbol_cache.get( p2, 0 ) == 0 );
-    CHECK( symbol_cache.get( p3, 0 ) == 3 );
+    map_memory memory;
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p2, 2 );
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p3, 3 );
+    CHECK( memory.get_symbol( p1 ) == 1 );
+    CHECK( memory.get_symbol( p2 ) == 0 );
+    CHECK( memory.get_symbol( p3 ) == 3 );
+}
+
+TEST_CASE( "map_memory_forgets_whole_chunks", "[map_memory]" )
+{
+    map_memory memory;
+    // Tiles of one submap share a chunk, including at negative coordinates.
+    const tripoint corner( -SEEX, -SEEY, 0 );
+    const tripoint other_corner( -1, -1, 0 );
+    memory.memorize_tile( two_chunks, corner, "t_floor", 1, 2 );
+    memory.memorize_tile( two_chunks, other_corner, "t_wall", 3, 90 );
+    CHECK( memory.chunk_count() == 1 );
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p2, 2 );
+    CHECK( memory.get_tile( corner ).tile.empty() );
+    CHECK( memory.get_tile( other_corner ).tile.empty() );
 }
 
 TEST_CASE( "map_memory_survives_save_lod", "[map_memory]" )
 {
     map_memory memory;
-    memory.memorize_symbol( 2, p1, 1 );
-    memory.memorize_symbol( 2, p2, 2 );
+    memory.memorize_symbol( two_chunks, p1, 1 );
+    memory.memorize_symbol( two_chunks, p2, 2 );
+    memory.memorize_tile( two_chunks, p2 + tripoint( 5, 7, 0 ), "t_floor", 1, 270 );
 
     // Save and reload
     std::ostringstream jsout_s;
@@ -76,23 +96,41 @@ TEST_CASE( "map_memory_survives_save_lod", "[map_memory]" )
     map_memory memory2;
     memory2.load( jsin );
 
-    memory.memorize_symbol( 2, p3, 3 );
-    memory2.memorize_symbol( 2, p3, 3 );
+    const memorized_terrain_tile tile = memory2.get_tile( p2 + tripoint( 5, 7, 0 ) );
+    CHECK( tile.tile == "t_floor" );
+    CHECK( tile.subtile == 1 );
+    CHECK( tile.rotation == 270 );
+
+    memory.memorize_symbol( two_chunks, p3, 3 );
+    memory2.memorize_symbol( two_chunks, p3, 3 );
     CHECK( memory.get_symbol( p1 ) == memory2.get_symbol( p1 ) );
     CHECK( memory.get_symbol( p2 ) == memory2.get_symbol( p2 ) );
     CHECK( memory.get_symbol( p3 ) == memory2.get_symbol( p3 ) );
 }
 
+TEST_CASE( "map_memory_loads_per_tile_format", "[map_memory]" )
+{
+    std::istringstream jsin_s( R"([[[1,2,0,"t_floor",1,2]],[[1,2,0,35],[-1,-1,0,64]]])" );
+    JsonIn jsin( jsin_s );
+    map_memory memory;
+    memory.load( jsin );
+    CHECK( memory.get_tile( tripoint( 1, 2, 0 ) ).tile == "t_floor" );
+    CHECK( memory.get_tile( tripoint( 1, 2, 0 ) ).rotation == 2 );
+    CHECK( memory.get_symbol( tripoint( 1, 2, 0 ) ) == 35 );
+    CHECK( memory.get_symbol( tripoint( -1, -1, 0 ) ) == 64 );
+    CHECK( memory.chunk_count() == 2 );
+}
+
 #include <chrono>
 
-TEST_CASE( "lru_cache_perf", "[.]" )
+TEST_CASE( "map_memory_perf", "[.]" )
 {
     constexpr int max_size = 1000000;
-    lru_cache<long> symbol_cache;
+    map_memory memory;
     const auto start1 = std::chrono::high_resolution_clock::now();
     for( int i = 0; i < 1000000; ++i ) {
         for( int j = -60; j <= 60; ++j ) {
-            symbol_cache.insert( max_size, { i, j, 0 }, 1 );
+            memory.memorize_symbol( max_size, { i, j, 0 }, 1 );
         }
     }
     const auto end1 = std::chrono::high_resolution_clock::now();
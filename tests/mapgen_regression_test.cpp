@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "faction.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "mapdata.h"
+#include "mapgen.h"
+#include "mapgen_functions.h"
+#include "omdata.h"
+#include "overmapbuffer.h"
+#include "rng.h"
+#include "trap.h"
+#include "vehicle.h"
+
+static constexpr int area_size = SEEX * 2;
+
+// Empties the overmap terrain that mapgen draws on.
+static void reset_mapgen_area( map &m )
+{
+    for( wrapped_vehicle &veh : m.get_vehicles() ) {
+        m.destroy_vehicle( veh.v );
+    }
+    for( int x = 0; x < area_size; x++ ) {
+        for( int y = 0; y < area_size; y++ ) {
+            const tripoint p( x, y, 0 );
+            m.furn_set( p, f_null );
+            m.ter_set( p, t_dirt );
+            m.i_clear( p );
+            m.remove_trap( p );
+            m.delete_signage( p );
+            m.delete_graffiti( p );
+            std::vector<field_id> fields;
+            for( auto &fd : m.field_at( p ) ) {
+                fields.push_back( fd.second.getFieldType() );
+            }
+            for( const field_id fd : fields ) {
+                m.remove_field( p, fd );
+            }
+        }
+    }
+}
+
+// Everything mapgen placed there, one line per square.
+static std::vector<std::string> mapgen_area_contents( map &m )
+{
+    std::vector<std::string> result;
+    for( int x = 0; x < area_size; x++ ) {
+        for( int y = 0; y < area_size; y++ ) {
+            const tripoint p( x, y, 0 );
+            std::ostringstream square;
+            square << m.ter( p ).id().str() << ' ' << m.furn( p ).id().str() << ' '
+                   << m.tr_at( p ).id.str();
+            for( const item &it : m.i_at( p ) ) {
+                square << ' ' << it.typeId() << ':' << it.charges;
+            }
+            for( auto &fd : m.field_at( p ) ) {
+                square << ' ' << fd.first;
+            }
+            result.push_back( square.str() );
+        }
+    }
+    for( wrapped_vehicle &veh : m.get_vehicles() ) {
+        std::ostringstream vehicle;
+        vehicle << veh.v->name << ' ' << veh.x << ',' << veh.y;
+        result.push_back( vehicle.str() );
+    }
+    return result;
+}
+
+// Runs mapgen compiled and as parsed from the same seed and compares what each placed.
+template<typename Generate>
+static void check_compiled_like_parsed( map &m, const Generate &generate )
+{
+    const unsigned int seed = 1234;
+    std::vector<std::string> contents[2];
+    for( int uncompiled = 0; uncompiled < 2; uncompiled++ ) {
+        mapgen_uncompiled = uncompiled != 0;
+        reset_mapgen_area( m );
+        srand( seed );
+        rng_set_engine_seed( seed );
+        generate();
+        contents[uncompiled] = mapgen_area_contents( m );
+    }
+    mapgen_uncompiled = false;
+    reset_mapgen_area( m );
+    CHECK( contents[0] == contents[1] );
+}
+
+TEST_CASE( "json_mapgen_runs_the_same_compiled", "[mapgen]" )
+{
+    // Some mapgen places npcs of the factions of a new game
+    g->faction_manager_ptr->create_if_needed();
+    // Some rotates the whole map it is given, so draw on a tinymap away from the player, as
+    // when the game generates a map
+    tinymap tm;
+    tm.load( 200, 200, 0, false );
+
+    std::map<std::string, oter_id> terrain_of_mapgen;
+    for( const oter_t &ot : overmap_terrains::get_all() ) {
+        terrain_of_mapgen.emplace( ot.get_mapgen_id(), ot.id.id() );
+    }
+    const regional_settings &settings = overmap_buffer.get_settings( 0, 0, 0 );
+    const oter_id field( "field" );
+
+    int compared = 0;
+    for( const auto &mapgens : oter_mapgen ) {
+        const auto terrain = terrain_of_mapgen.find( mapgens.first );
+        if( terrain == terrain_of_mapgen.end() ) {
+            continue;
+        }
+        for( const std::shared_ptr<mapgen_function> &mapgen : mapgens.second ) {
+            mapgen_function_json *const json = dynamic_cast<mapgen_function_json *>( mapgen.get() );
+            if( json == nullptr || json->weight < 1 ) {
+                continue;
+            }
+            CAPTURE( mapgens.first );
+            check_compiled_like_parsed( tm, [&]() {
+                mapgendata dat( field, field, field, field, field, field, field, field, field,
+                                field, 0, settings, tm );
+                json->generate( &tm, terrain->second, dat, calendar::turn, 1.0f );
+            } );
+            compared++;
+        }
+    }
+    CHECK( compared > 100 );
+}
+
+TEST_CASE( "nested_json_mapgen_runs_the_same_compiled", "[mapgen]" )
+{
+    g->faction_manager_ptr->create_if_needed();
+    tinymap tm;
+    tm.load( 200, 200, 0, false );
+
+    const regional_settings &settings = overmap_buffer.get_settings( 0, 0, 0 );
+    const oter_id field( "field" );
+
+    int compared = 0;
+    for( const auto &mapgens : nested_mapgen ) {
+        for( const std::shared_ptr<mapgen_function_json_nested> &nested : mapgens.second ) {
+            if( !nested->setup_lazily() ) {
+                continue;
+            }
+            CAPTURE( mapgens.first );
+            check_compiled_like_parsed( tm, [&]() {
+                mapgendata dat( field, field, field, field, field, field, field, field, field,
+                                field, 0, settings, tm );
+                nested->nest( dat, 0, 0, 1.0f );
+            } );
+            compared++;
+        }
+    }
+    CHECK( compared > 10 );
+}
+
+TEST_CASE( "update_json_mapgen_runs_the_same_compiled", "[mapgen]" )
+{
+    g->faction_manager_ptr->create_if_needed();
+    // Update mapgen loads the submaps of an overmap terrain itself, these are the same ones
+    const tripoint omt_pos( 100, 100, 0 );
+    tinymap tm;
+    tm.load( omt_pos.x * 2, omt_pos.y * 2, omt_pos.z, false );
+
+    int compared = 0;
+    for( const auto &mapgens : update_mapgen ) {
+        for( const std::shared_ptr<update_mapgen_function_json> &update : mapgens.second ) {
+            if( !update->setup_lazily() ) {
+                continue;
+            }
+            CAPTURE( mapgens.first );
+            check_compiled_like_parsed( tm, [&]() {
+                update->update_map( omt_pos, 0, 0, nullptr );
+            } );
+            compared++;
+        }
+    }
+    CHECK( compared > 10 );
+}
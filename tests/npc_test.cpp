@@ -1,11 +1,15 @@
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "catch/catch.hpp"
 #include "common_types.h"
 #include "faction.h"
 #include "field.h"
 #include "game.h"
+#include "item_location.h"
 #include "map.h"
+#include "map_helpers.h"
 #include "npc.h"
 #include "npc_class.h"
 #include "overmapbuffer.h"
@@ -418,6 +422,7 @@ TEST_CASE( "npc-movement" )
 TEST_CASE( "npc_can_target_player" )
 {
     // Set to daytime for visibiliity
+    const calendar old_calendar = calendar::turn;
     calendar::turn = HOURS( 12 );
 
     g->faction_manager_ptr->create_if_needed();
@@ -459,4 +464,179 @@ TEST_CASE( "npc_can_target_player" )
     hostile->regen_ai_cache();
     REQUIRE( hostile->current_target() != nullptr );
     CHECK( hostile->current_target() == static_cast<Creature *>( &g->u ) );
+    calendar::turn = old_calendar;
+}
+
+// Takes the npc out of the game for good, unloading it would only put it on the overmap.
+static void remove_test_npc( const int id )
+{
+    overmap_buffer.remove_npc( id );
+    g->unload_npcs();
+}
+
+TEST_CASE( "npc_danger_field_matches_the_map", "[npc][danger]" )
+{
+    clear_map();
+    const calendar old_calendar = calendar::turn;
+    calendar::turn = HOURS( 12 );
+    g->faction_manager_ptr->create_if_needed();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    const tripoint center = g->u.pos() + point( 10, 0 );
+
+    g->m.add_field( center + point( 2, 0 ), fd_fire, 1 );
+    g->m.add_field( center + point( -5, 3 ), fd_fire, 2 );
+    g->m.add_field( center + point( 30, -20 ), fd_fire, 3 );
+
+    item grenade( "grenade_act" );
+    grenade.active = true;
+    grenade.charges = 1;
+    g->m.i_clear( center + point( 1, 1 ) );
+    g->m.add_item( center + point( 1, 1 ), grenade );
+
+    SECTION( "fire positions are the same as the fields on the map" ) {
+        std::vector<tripoint> scanned;
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                if( g->m.get_field( tripoint( x, y, center.z ), fd_fire ) != nullptr ) {
+                    scanned.emplace_back( x, y, center.z );
+                }
+            }
+        }
+        std::vector<tripoint> cached;
+        for( const point &p : g->m.get_fire_positions( center.z ) ) {
+            cached.emplace_back( p, center.z );
+        }
+        CHECK( cached == scanned );
+
+        g->m.remove_field( center + point( 2, 0 ), fd_fire );
+        CHECK( g->m.get_fire_positions( center.z ).size() == scanned.size() - 1 );
+    }
+
+    SECTION( "active items are the same as the ones found by radius" ) {
+        const auto nearby = g->m.get_active_items_in_radius( center, MAX_VIEW_DISTANCE );
+        std::vector<tripoint> expected;
+        for( const item_location &loc : nearby ) {
+            expected.push_back( loc.position() );
+        }
+        std::vector<tripoint> listed;
+        for( const auto &elem : g->m.get_active_items_on_level( center.z ) ) {
+            if( rl_dist( center, elem.first ) <= MAX_VIEW_DISTANCE ) {
+                listed.push_back( elem.first );
+            }
+        }
+        CHECK( listed == expected );
+        CHECK( std::find( listed.begin(), listed.end(), center + point( 1, 1 ) ) != listed.end() );
+
+        g->m.i_clear( center + point( 1, 1 ) );
+        for( const auto &elem : g->m.get_active_items_on_level( center.z ) ) {
+            CHECK( elem.first != center + point( 1, 1 ) );
+        }
+    }
+
+    SECTION( "active items removed through another map are gone from the list" ) {
+        const tripoint grenade_pos = center + point( 1, 1 );
+        const auto lists_grenade = [&grenade_pos]() {
+            const auto &listed = g->m.get_active_items_on_level( grenade_pos.z );
+            return std::any_of( listed.begin(), listed.end(),
+            [&grenade_pos]( const std::pair<tripoint, item *> &elem ) {
+                return elem.first == grenade_pos;
+            } );
+        };
+        const string_id<npc_template> test_guy( "thug" );
+        const int model_id = g->m.place_npc( 10, 10, test_guy, true );
+        g->load_npcs();
+        npc *guy = g->find_npc( model_id );
+        REQUIRE( guy != nullptr );
+        guy->setpos( center );
+        guy->regen_ai_cache();
+        REQUIRE( lists_grenade() );
+
+        // The submaps are shared with the tinymap, the map itself doesn't see the item go
+        const tripoint abs_sub = g->m.get_abs_sub();
+        tinymap tm;
+        tm.load( abs_sub.x + grenade_pos.x / SEEX, abs_sub.y + grenade_pos.y / SEEY, grenade_pos.z,
+                 false );
+        const tripoint tm_pos( grenade_pos.x % SEEX, grenade_pos.y % SEEY, grenade_pos.z );
+        REQUIRE( tm.i_at( tm_pos ).size() == 1 );
+        tm.i_clear( tm_pos );
+
+        CHECK_FALSE( lists_grenade() );
+        // Looks at the items of the list, which must not include the removed one
+        guy->regen_ai_cache();
+        remove_test_npc( model_id );
+    }
+
+    SECTION( "npcs fear fire close to them" ) {
+        const efftype_id effect_npc_fire_bad( "npc_fire_bad" );
+        const string_id<npc_template> test_guy( "thug" );
+        const int model_id = g->m.place_npc( 10, 10, test_guy, true );
+        g->load_npcs();
+        npc *guy = g->find_npc( model_id );
+        REQUIRE( guy != nullptr );
+
+        guy->setpos( center + point( 0, -10 ) );
+        guy->regen_ai_cache();
+        CHECK_FALSE( guy->has_effect( effect_npc_fire_bad ) );
+
+        // Fire in a fireplace is fine
+        g->m.furn_set( center + point( 0, -8 ), furn_id( "f_fireplace" ) );
+        g->m.add_field( center + point( 0, -8 ), fd_fire, 1 );
+        guy->regen_ai_cache();
+        CHECK_FALSE( guy->has_effect( effect_npc_fire_bad ) );
+
+        guy->setpos( center );
+        guy->regen_ai_cache();
+        CHECK( guy->has_effect( effect_npc_fire_bad ) );
+        remove_test_npc( model_id );
+    }
+    g->m.i_clear( center + point( 1, 1 ) );
+    clear_map();
+    calendar::turn = old_calendar;
+}
+
+TEST_CASE( "npc_scavenging_notices_new_items", "[npc][scavenge]" )
+{
+    g->faction_manager_ptr->create_if_needed();
+    clear_map();
+    const calendar old_calendar = calendar::turn;
+    calendar::turn = HOURS( 12 );
+    g->place_player( tripoint( 60, 60, 0 ) );
+    const tripoint center = g->u.pos() + point( 10, 0 );
+    const tripoint spot = center + point( 2, 0 );
+    g->m.i_clear( spot );
+
+    const string_id<npc_template> test_guy( "thug" );
+    const int model_id = g->m.place_npc( 10, 10, test_guy, true );
+    g->load_npcs();
+    npc *guy = g->find_npc( model_id );
+    REQUIRE( guy != nullptr );
+    guy->setpos( center );
+    g->reset_light_level();
+    g->m.build_map_cache( center.z );
+
+    // Liquids are never picked up, so the npc remembers there is nothing of value there
+    const uint64_t stamp_before = g->m.item_stamp( spot );
+    g->m.add_item( spot, item( "water" ) );
+    const uint64_t stamp_water = g->m.item_stamp( spot );
+    CHECK( stamp_water != stamp_before );
+    guy->find_item();
+    CHECK_FALSE( guy->fetching_item );
+
+    // Nothing changed, so nothing is valued again
+    const int valued = guy->get_scavenge_memory().squares_valued;
+    CHECK( valued > 0 );
+    guy->find_item();
+    CHECK_FALSE( guy->fetching_item );
+    CHECK( guy->get_scavenge_memory().squares_valued == valued );
+
+    g->m.add_item( spot, item( "diamond" ) );
+    CHECK( g->m.item_stamp( spot ) != stamp_water );
+    guy->find_item();
+    CHECK( guy->fetching_item );
+    CHECK( guy->wanted_item_pos == spot );
+    CHECK( guy->get_scavenge_memory().squares_valued == valued + 1 );
+
+    g->m.i_clear( spot );
+    remove_test_npc( model_id );
+    calendar::turn = old_calendar;
 }
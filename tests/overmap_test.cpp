@@ -1,7 +1,19 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "catch/catch.hpp"
+#include "filesystem.h"
+#include "line.h"
 #include "map.h"
+#include "mongroup.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "rng.h"
 
 TEST_CASE( "set_and_get_overmap_scents" )
 {
@@ -93,3 +105,297 @@ TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin" )
     CHECK( found_optional == true );
 }
 
+TEST_CASE( "overmapbuffer_saves_only_overmaps_in_use", "[overmap][save]" )
+{
+    const point om_pos( 41, 41 );
+    overmap_special_batch test_specials( om_pos );
+    overmap_buffer.create_custom_overmap( om_pos.x, om_pos.y, test_specials );
+    const std::string terrain = overmapbuffer::terrain_filename( om_pos.x, om_pos.y );
+
+    overmap_buffer.save();
+    REQUIRE( file_exist( terrain ) );
+    REQUIRE( remove_file( terrain ) );
+
+    // Nothing asked for the overmap since, so it is not written again
+    overmap_buffer.save();
+    CHECK_FALSE( file_exist( terrain ) );
+
+    overmap_buffer.ter( om_pos.x * OMAPX + 10, om_pos.y * OMAPY + 10, 0 ) = oter_id( "field" );
+    overmap_buffer.save();
+    CHECK( file_exist( terrain ) );
+}
+
+
+TEST_CASE( "overmap_terrain_stays_in_runs_until_changed", "[overmap][save]" )
+{
+    const point om_pos( 42, 41 );
+    overmap_special_batch test_specials( om_pos );
+    overmap_buffer.create_custom_overmap( om_pos.x, om_pos.y, test_specials );
+    const overmap &generated = *overmap_buffer.get_existing( om_pos.x, om_pos.y );
+    std::ostringstream saved;
+    generated.serialize( saved );
+
+    overmap loaded( om_pos.x, om_pos.y );
+    std::istringstream saved_in( saved.str() );
+    loaded.unserialize( saved_in );
+
+    // Looked up in the runs, nothing unpacked yet
+    const overmap &packed = loaded;
+    int mismatches = 0;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                if( packed.get_ter( x, y, z ) != generated.get_ter( x, y, z ) ) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+
+    // The layers are written back as they were read
+    const std::string layers_end = "\"region_id\"";
+    std::ostringstream resaved;
+    loaded.serialize( resaved );
+    const std::string resaved_str = resaved.str();
+    REQUIRE( saved.str().find( layers_end ) != std::string::npos );
+    CHECK( resaved_str.substr( 0, resaved_str.find( layers_end ) ) ==
+           saved.str().substr( 0, saved.str().find( layers_end ) ) );
+
+    const oter_id changed = generated.get_ter( 10, 10, 0 ) == oter_id( "field" ) ?
+                            oter_id( "forest" ) : oter_id( "field" );
+    loaded.ter( 10, 10, 0 ) = changed;
+    CHECK( loaded.get_ter( 10, 10, 0 ) == changed );
+    CHECK( loaded.get_ter( 11, 10, 0 ) == generated.get_ter( 11, 10, 0 ) );
+    CHECK( loaded.get_ter( 10, 11, 0 ) == generated.get_ter( 10, 11, 0 ) );
+    CHECK( loaded.get_ter( 10, 10, -1 ) == generated.get_ter( 10, 10, -1 ) );
+}
+
+// The searches of the overmap buffer done the way they were before, tile by tile.
+static std::vector<tripoint> find_all_by_scan( const tripoint &origin, const std::string &type,
+        const int dist, const bool allow_subtype_matches )
+{
+    std::vector<tripoint> result;
+    for( int x = origin.x - dist; x <= origin.x + dist; x++ ) {
+        for( int y = origin.y - dist; y <= origin.y + dist; y++ ) {
+            const tripoint loc( x, y, origin.z );
+            if( allow_subtype_matches ? overmap_buffer.check_ot_subtype_existing( type, loc ) :
+                overmap_buffer.check_ot_type_existing( type, loc ) ) {
+                result.push_back( loc );
+            }
+        }
+    }
+    return result;
+}
+
+static tripoint find_closest_by_scan( const tripoint &origin, const std::string &type,
+                                      const int radius, const bool allow_subtype_matches )
+{
+    const auto findable = [&]( const tripoint & loc ) {
+        return allow_subtype_matches ? overmap_buffer.check_ot_subtype_existing( type, loc ) :
+               overmap_buffer.check_ot_type_existing( type, loc );
+    };
+    if( findable( origin ) ) {
+        return origin;
+    }
+    for( int dist = 1; dist <= radius; dist++ ) {
+        for( int i = 0; i < dist * 2; i++ ) {
+            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+                const tripoint edges[] = {
+                    tripoint( origin.x - dist + i, origin.y - dist, z ),
+                    tripoint( origin.x + dist - i, origin.y + dist, z ),
+                    tripoint( origin.x - dist, origin.y + dist - i, z ),
+                    tripoint( origin.x + dist, origin.y - dist + i, z )
+                };
+                for( const tripoint &loc : edges ) {
+                    if( findable( loc ) ) {
+                        return loc;
+                    }
+                }
+            }
+        }
+    }
+    return overmap::invalid_tripoint;
+}
+
+TEST_CASE( "overmap_searches_find_what_a_scan_finds", "[overmap]" )
+{
+    // Two overmaps side by side, searched from near the border between them
+    overmap_buffer.get( 0, 0 );
+    overmap_buffer.get( 1, 0 );
+    const tripoint origin( OMAPX - 3, OMAPY / 2, 0 );
+    const struct {
+        std::string type;
+        bool subtypes;
+    } searches[] = { { "road", true }, { "forest", false }, { "house", true }, { "field", false } };
+
+    for( const auto &search : searches ) {
+        CAPTURE( search.type );
+        for( const int dist : { 5, 40 } ) {
+            CHECK( overmap_buffer.find_all( origin, search.type, dist, false, search.subtypes,
+                                            true ) ==
+                   find_all_by_scan( origin, search.type, dist, search.subtypes ) );
+            CHECK( overmap_buffer.find_closest( origin, search.type, dist, false, search.subtypes,
+                                                true ) ==
+                   find_closest_by_scan( origin, search.type, dist, search.subtypes ) );
+        }
+    }
+
+    // Terrain changed after a search is found by the next one, and no longer where it was
+    const tripoint bunker( origin.x + 4, origin.y - 2, 0 );
+    const oter_id old_ter = overmap_buffer.ter( bunker );
+    overmap_buffer.ter( bunker ) = oter_id( "bunker_north" );
+    CHECK( overmap_buffer.find_closest( origin, "bunker", 10, false, true, true ) ==
+           find_closest_by_scan( origin, "bunker", 10, true ) );
+    const std::vector<tripoint> bunkers = overmap_buffer.find_all( origin, "bunker", 10, false,
+                                          true, true );
+    CHECK( std::find( bunkers.begin(), bunkers.end(), bunker ) != bunkers.end() );
+    overmap_buffer.ter( bunker ) = old_ter;
+    CHECK( overmap_buffer.find_all( origin, "bunker", 10, false, true, true ) ==
+           find_all_by_scan( origin, "bunker", 10, true ) );
+}
+
+TEST_CASE( "mongroup_store_indexes_groups_by_position", "[overmap][mongroup]" )
+{
+    const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+    mongroup_store store;
+    mongroup &first = store.insert( mongroup( GROUP_ZOMBIE, 10, 10, 0, 1, 5 ) );
+    store.insert( mongroup( GROUP_ZOMBIE, 10, 10, 0, 1, 6 ) );
+    store.insert( mongroup( GROUP_ZOMBIE, 40, 10, 0, 1, 7 ) );
+    store.insert( mongroup( GROUP_ZOMBIE, -3, -30, 0, 1, 8 ) );
+    REQUIRE( store.size() == 4 );
+
+    CHECK( store.groups_at( tripoint( 10, 10, 0 ) ).size() == 2 );
+    CHECK( store.groups_at( tripoint( 10, 10, 1 ) ).empty() );
+    CHECK( store.groups_at( tripoint( -3, -30, 0 ) ).size() == 1 );
+    CHECK( store.groups_in_radius( tripoint( 12, 12, 0 ), 5 ).size() == 2 );
+    CHECK( store.groups_in_radius( tripoint( 12, 12, 0 ), 30 ).size() == 3 );
+
+    SECTION( "moved groups are found at their new position" ) {
+        auto it = store.begin();
+        REQUIRE( &*it == &first );
+        first.pos = tripoint( 38, 10, 0 );
+        store.reindex( it );
+        CHECK( store.groups_at( tripoint( 10, 10, 0 ) ).size() == 1 );
+        CHECK( store.groups_at( tripoint( 38, 10, 0 ) ).size() == 1 );
+        CHECK( store.groups_in_radius( tripoint( 40, 10, 0 ), 2 ).size() == 2 );
+    }
+
+    SECTION( "removing groups keeps the others in place and reuses the slot" ) {
+        std::vector<mongroup *> remaining = store.groups_at( tripoint( 40, 10, 0 ) );
+        REQUIRE( remaining.size() == 1 );
+        auto it = store.erase( store.begin() );
+        CHECK( it->population == 6 );
+        CHECK( store.size() == 3 );
+        CHECK( store.groups_at( tripoint( 10, 10, 0 ) ).size() == 1 );
+        CHECK( store.groups_at( tripoint( 40, 10, 0 ) ).front() == remaining.front() );
+
+        mongroup &added = store.insert( mongroup( GROUP_ZOMBIE, 0, 0, 0, 1, 9 ) );
+        CHECK( &added == &first );
+        CHECK( store.size() == 4 );
+    }
+}
+
+TEST_CASE( "horde_store_perf", "[.]" )
+{
+    const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+    const int num_hordes = 5000;
+    const int iterations = 100;
+    std::vector<mongroup> hordes;
+    for( int i = 0; i < num_hordes; i++ ) {
+        mongroup mg( GROUP_ZOMBIE, rng( 0, OMAPX * 2 - 1 ), rng( 0, OMAPY * 2 - 1 ), 0, 1, 10 );
+        mg.horde = true;
+        hordes.push_back( mg );
+    }
+
+    // What move_hordes and signal_hordes used to do: move every group through a temporary
+    // multimap and scan all of them for each signal.
+    std::multimap<tripoint, mongroup> old_store;
+    for( const mongroup &mg : hordes ) {
+        old_store.emplace( mg.pos, mg );
+    }
+    int heard_old = 0;
+    const auto start_old = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        std::multimap<tripoint, mongroup> moved;
+        for( auto it = old_store.begin(); it != old_store.end(); ) {
+            mongroup &mg = it->second;
+            mg.pos.x = ( mg.pos.x + 1 ) % ( OMAPX * 2 );
+            moved.emplace( mg.pos, mg );
+            old_store.erase( it++ );
+        }
+        old_store.insert( moved.begin(), moved.end() );
+        const tripoint signal( i % ( OMAPX * 2 ), OMAPY, 0 );
+        for( const auto &elem : old_store ) {
+            if( rl_dist( signal, elem.second.pos ) <= 20 ) {
+                heard_old++;
+            }
+        }
+    }
+    const auto end_old = std::chrono::high_resolution_clock::now();
+
+    mongroup_store new_store;
+    for( const mongroup &mg : hordes ) {
+        new_store.insert( mg );
+    }
+    int heard_new = 0;
+    const auto start_new = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        for( auto it = new_store.begin(); it != new_store.end(); ++it ) {
+            it->pos.x = ( it->pos.x + 1 ) % ( OMAPX * 2 );
+            new_store.reindex( it );
+        }
+        const tripoint signal( i % ( OMAPX * 2 ), OMAPY, 0 );
+        heard_new += new_store.groups_in_radius( signal, 20 ).size();
+    }
+    const auto end_new = std::chrono::high_resolution_clock::now();
+    CHECK( heard_old == heard_new );
+
+    const long old_time = std::chrono::duration_cast<std::chrono::microseconds>
+                          ( end_old - start_old ).count();
+    const long new_time = std::chrono::duration_cast<std::chrono::microseconds>
+                          ( end_new - start_new ).count();
+    printf( "%d moves and signals of %d hordes: multimap %ld microseconds, "
+            "store %ld microseconds.\n", iterations, num_hordes, old_time, new_time );
+}
+
+TEST_CASE( "npc_paths_are_reused_along_the_way", "[overmap][npc]" )
+{
+    const tripoint src( 10, 10, 0 );
+    const tripoint dest( 20, 10, 0 );
+    std::map<tripoint, oter_id> old_terrain;
+    for( int x = 5; x <= 25; x++ ) {
+        for( int y = 5; y <= 15; y++ ) {
+            old_terrain.emplace( tripoint( x, y, 0 ), overmap_buffer.ter( x, y, 0 ) );
+            overmap_buffer.ter( x, y, 0 ) = oter_id( "field" );
+        }
+    }
+    overmap_buffer.take_npc_path_stats();
+
+    const std::vector<tripoint> path = overmap_buffer.get_npc_path( src, dest );
+    REQUIRE( path.size() > 2 );
+    CHECK( path.front() == dest );
+    CHECK( path.back() == src );
+
+    // One step further along the way the rest of the path is reused
+    const tripoint next = path[path.size() - 2];
+    const std::vector<tripoint> rest = overmap_buffer.get_npc_path( next, dest );
+    CHECK( rest == std::vector<tripoint>( path.begin(), path.end() - 1 ) );
+    npc_path_cache_stats stats = overmap_buffer.take_npc_path_stats();
+    CHECK( stats.hits == 1 );
+    CHECK( stats.misses == 1 );
+
+    // Blocking the path makes it look for a new one
+    const tripoint blocked = path[path.size() / 2];
+    overmap_buffer.ter( blocked ) = oter_id( "empty_rock" );
+    const std::vector<tripoint> detour = overmap_buffer.get_npc_path( next, dest );
+    REQUIRE_FALSE( detour.empty() );
+    CHECK( std::find( detour.begin(), detour.end(), blocked ) == detour.end() );
+    stats = overmap_buffer.take_npc_path_stats();
+    CHECK( stats.hits == 0 );
+    CHECK( stats.misses == 1 );
+
+    for( const auto &terrain : old_terrain ) {
+        overmap_buffer.ter( terrain.first ) = terrain.second;
+    }
+}
@@ -0,0 +1,146 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "field.h"
+#include "game.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "rng.h"
+#include "sounds.h"
+#include "weather.h"
+
+static const tripoint sound_source( 60, 60, 0 );
+
+static void wall_in( const tripoint &center, const ter_id &wall = ter_id( "t_wall" ) )
+{
+    for( const tripoint &p : g->m.points_in_radius( center, 1 ) ) {
+        if( p != center ) {
+            g->m.ter_set( p, wall );
+        }
+    }
+}
+
+static void make_noise( const tripoint &p, int volume )
+{
+    sounds::reset_sounds();
+    sounds::sound( p, volume, sounds::sound_t::combat, "a test noise" );
+    g->m.build_map_cache( p.z, true );
+    sounds::process_sounds();
+}
+
+TEST_CASE( "monsters_hear_sounds_in_the_open", "[sounds]" )
+{
+    clear_map_and_put_player_underground();
+    g->weather = WEATHER_CLEAR;
+    monster &zombie = spawn_test_monster( "mon_zombie", sound_source + point( 10, 0 ) );
+    monster &far_zombie = spawn_test_monster( "mon_zombie", sound_source + point( 0, 25 ) );
+
+    make_noise( sound_source, 15 );
+    CHECK( zombie.wandf > 0 );
+    CHECK( rl_dist( zombie.wander_pos, sound_source ) <= 3 );
+    CHECK( far_zombie.wandf == 0 );
+}
+
+TEST_CASE( "walls_muffle_sounds", "[sounds]" )
+{
+    clear_map_and_put_player_underground();
+    g->weather = WEATHER_CLEAR;
+    const tripoint walled_pos = sound_source + point( 10, 0 );
+    wall_in( walled_pos );
+    monster &walled_zombie = spawn_test_monster( "mon_zombie", walled_pos );
+
+    SECTION( "a quiet sound doesn't get through the walls" ) {
+        make_noise( sound_source, 15 );
+        CHECK( walled_zombie.wandf == 0 );
+    }
+
+    SECTION( "a loud sound still does" ) {
+        make_noise( sound_source, 40 );
+        CHECK( walled_zombie.wandf > 0 );
+    }
+
+    SECTION( "sounds travel around walls through openings" ) {
+        g->m.ter_set( walled_pos + point( -1, 0 ), t_dirt );
+        make_noise( sound_source, 15 );
+        CHECK( walled_zombie.wandf > 0 );
+    }
+    clear_map();
+}
+
+TEST_CASE( "closed_windows_muffle_sounds_but_smoke_does_not", "[sounds]" )
+{
+    clear_map_and_put_player_underground();
+    g->weather = WEATHER_CLEAR;
+    const tripoint walled_pos = sound_source + point( 10, 0 );
+    monster &zombie = spawn_test_monster( "mon_zombie", walled_pos );
+
+    SECTION( "closed windows" ) {
+        wall_in( walled_pos, ter_id( "t_window" ) );
+        make_noise( sound_source, 15 );
+        CHECK( zombie.wandf == 0 );
+    }
+
+    SECTION( "thick smoke" ) {
+        for( const tripoint &p : g->m.points_in_radius( walled_pos, 2 ) ) {
+            g->m.add_field( p, fd_smoke, 3 );
+        }
+        make_noise( sound_source, 15 );
+        CHECK( zombie.wandf > 0 );
+    }
+    clear_map();
+}
+
+TEST_CASE( "monsters_hear_sounds_from_beyond_the_map_edge", "[sounds]" )
+{
+    clear_map_and_put_player_underground();
+    g->weather = WEATHER_CLEAR;
+    const tripoint outside( -5, 60, 0 );
+    monster &zombie = spawn_test_monster( "mon_zombie", tripoint( 3, 60, 0 ) );
+    monster &far_zombie = spawn_test_monster( "mon_zombie", tripoint( 30, 60, 0 ) );
+
+    make_noise( outside, 15 );
+    CHECK( zombie.wandf > 0 );
+    CHECK( far_zombie.wandf == 0 );
+}
+
+TEST_CASE( "sound_propagation_perf", "[.]" )
+{
+    clear_map_and_put_player_underground();
+    g->weather = WEATHER_CLEAR;
+    // Scatter some buildings around to give the sounds something to go around
+    for( int i = 0; i < 40; i++ ) {
+        wall_in( tripoint( rng( 1, MAPSIZE_X - 2 ), rng( 1, MAPSIZE_Y - 2 ), 0 ) );
+    }
+    int monsters = 0;
+    for( int i = 0; i < 300; i++ ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( g->is_empty( p ) ) {
+            spawn_test_monster( "mon_zombie", p );
+            monsters++;
+        }
+    }
+    g->m.build_map_cache( 0, true );
+
+    const int turns = 20;
+    long total = 0;
+    for( int turn = 0; turn < turns; turn++ ) {
+        sounds::reset_sounds();
+        for( int i = 0; i < 300; i++ ) {
+            const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+            sounds::sound( p, rng( 20, 80 ), sounds::sound_t::combat, "a gunshot" );
+        }
+        const auto start = std::chrono::high_resolution_clock::now();
+        sounds::process_sounds();
+        const auto end = std::chrono::high_resolution_clock::now();
+        total += std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    }
+    printf( "%d turns of 300 gunshots heard by %d monsters in %ld microseconds.\n",
+            turns, monsters, total );
+    clear_map();
+}
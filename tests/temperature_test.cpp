@@ -1,7 +1,12 @@
 #include "catch/catch.hpp"
 #include "calendar.h"
+#include "field.h"
+#include "game.h"
 #include "itype.h"
 #include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
 
 bool is_nearly( float value, float expected )
 {
@@ -214,3 +219,37 @@ TEST_CASE( "Rate of temperature change" )
         CHECK( is_nearly( meat1.temperature, meat2.temperature ) );
     }
 }
+
+TEST_CASE( "Heat radiation from fire" )
+{
+    clear_map();
+    const tripoint fire_pos( 20, 20, 0 );
+    g->m.add_field( fire_pos, fd_fire, 3 );
+    g->m.build_map_cache( 0, true );
+
+    SECTION( "Fire heats tiles in line of sight" ) {
+        CHECK( get_heat_radiation( fire_pos, false ) == 6 * 3 * 3 );
+        CHECK( get_heat_radiation( fire_pos + tripoint( 2, 0, 0 ), false ) == 6 * 3 * 3 / 2 );
+        CHECK( get_heat_radiation( fire_pos + tripoint( 6, 6, 0 ), false ) == 6 * 3 * 3 / 6 );
+        CHECK( get_heat_radiation( fire_pos + tripoint( 7, 0, 0 ), false ) == 0 );
+    }
+
+    SECTION( "Only adjacent fires give direct heat" ) {
+        CHECK( get_heat_radiation( fire_pos + tripoint( 1, 1, 0 ), true ) == 3 );
+        CHECK( get_heat_radiation( fire_pos + tripoint( 2, 0, 0 ), true ) == 0 );
+    }
+
+    SECTION( "Walls block heat radiation" ) {
+        g->m.ter_set( fire_pos + tripoint( 1, 0, 0 ), t_wall );
+        g->m.build_map_cache( 0, true );
+        CHECK( get_heat_radiation( fire_pos + tripoint( 2, 0, 0 ), false ) == 0 );
+        CHECK( get_heat_radiation( fire_pos + tripoint( -2, 0, 0 ), false ) == 6 * 3 * 3 / 2 );
+    }
+
+    SECTION( "Heat goes away with the fire" ) {
+        g->m.remove_field( fire_pos, fd_fire );
+        CHECK( get_heat_radiation( fire_pos + tripoint( 2, 0, 0 ), false ) == 0 );
+    }
+
+    g->m.remove_field( fire_pos, fd_fire );
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "map.h"
+#include "vehicle.h"
+
+void clear_game_drag( const ter_id &terrain );
+
+static rectangle footprint( vehicle &veh )
+{
+    const std::set<tripoint> &points = veh.get_points( true );
+    rectangle result( point_max, point_min );
+    for( const tripoint &p : points ) {
+        result.p_min = point( std::min( result.p_min.x, p.x ), std::min( result.p_min.y, p.y ) );
+        result.p_max = point( std::max( result.p_max.x, p.x ), std::max( result.p_max.y, p.y ) );
+    }
+    return result;
+}
+
+static bool hits_vehicle( vehicle &veh, const tripoint &dp )
+{
+    // Same as map::vehmove, which takes the shift of the pivot point out of the movement
+    veh.precalc_mounts( 1, veh.face.dir(), veh.pivot_point() );
+    std::vector<veh_collision> colls;
+    veh.collision( colls, dp - veh.pivot_displacement(), true );
+    return std::any_of( colls.begin(), colls.end(), []( const veh_collision & coll ) {
+        return coll.type == veh_coll_veh;
+    } );
+}
+
+TEST_CASE( "vehicle_collisions_with_cached_vehicle_areas", "[vehicle][collision]" )
+{
+    clear_game_drag( ter_id( "t_pavement" ) );
+    vehicle *front = g->m.add_vehicle( vproto_id( "car" ), tripoint( 60, 60, 0 ), 0, 0, 0 );
+    REQUIRE( front != nullptr );
+
+    const rectangle front_area = footprint( *front );
+    const rectangle whole_map( point( 0, 0 ), point( MAPSIZE_X, MAPSIZE_Y ) );
+    const std::vector<rectangle> areas = g->m.get_vehicle_areas( whole_map, 0, nullptr );
+    REQUIRE( areas.size() == 1 );
+    CHECK( areas[0].p_min.x <= front_area.p_min.x );
+    CHECK( areas[0].p_min.y <= front_area.p_min.y );
+    CHECK( areas[0].p_max.x >= front_area.p_max.x );
+    CHECK( areas[0].p_max.y >= front_area.p_max.y );
+    CHECK( g->m.get_vehicle_areas( whole_map, 0, front ).empty() );
+
+    // Same car right behind the first one, bumper to bumper
+    const int length = front_area.p_max.x - front_area.p_min.x + 1;
+    vehicle *back = g->m.add_vehicle( vproto_id( "car" ), tripoint( 60 - length, 60, 0 ), 0, 0, 0 );
+    REQUIRE( back != nullptr );
+    REQUIRE( footprint( *back ).p_max.x + 1 == front_area.p_min.x );
+
+    CHECK( hits_vehicle( *back, tripoint( 1, 0, 0 ) ) );
+    CHECK_FALSE( hits_vehicle( *back, tripoint( -1, 0, 0 ) ) );
+    CHECK( hits_vehicle( *front, tripoint( -1, 0, 0 ) ) );
+    CHECK_FALSE( hits_vehicle( *front, tripoint( 1, 0, 0 ) ) );
+
+    // Moving a vehicle moves its cached area along
+    tripoint front_pos = front->global_pos3();
+    front->precalc_mounts( 1, front->face.dir(), front->pivot_point() );
+    g->m.displace_vehicle( front_pos, tripoint( 5, 0, 0 ) - front->pivot_displacement() );
+    const rectangle moved_area = footprint( *front );
+    REQUIRE( moved_area.p_min.x == front_area.p_min.x + 5 );
+    CHECK_FALSE( hits_vehicle( *back, tripoint( 1, 0, 0 ) ) );
+    const std::vector<rectangle> moved = g->m.get_vehicle_areas( whole_map, 0, back );
+    REQUIRE( moved.size() == 1 );
+    CHECK( moved[0].p_min.x == moved_area.p_min.x );
+    CHECK( moved[0].p_max.x == moved_area.p_max.x );
+}
+
+TEST_CASE( "vehicle_convoy_perf", "[.]" )
+{
+    clear_game_drag( ter_id( "t_pavement" ) );
+    std::vector<vehicle *> convoy;
+    for( int lane = 0; lane < 4; lane++ ) {
+        for( int car = 0; car < 3; car++ ) {
+            vehicle *veh = g->m.add_vehicle( vproto_id( "car" ),
+                                             tripoint( 10 + car * 12, 20 + lane * 8, 0 ), 0, 0, 0 );
+            REQUIRE( veh != nullptr );
+            convoy.push_back( veh );
+        }
+    }
+
+    const int turns = 20;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int turn = 0; turn < turns; turn++ ) {
+        for( vehicle *veh : convoy ) {
+            veh->velocity = 1000;
+            veh->cruise_velocity = 1000;
+        }
+        g->m.vehmove();
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const long elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    printf( "convoy of %d vehicles: %d turns in %ld microseconds.\n",
+            static_cast<int>( convoy.size() ), turns, elapsed );
+}
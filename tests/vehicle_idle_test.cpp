@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "submap.h"
+#include "vehicle.h"
+#include "weather.h"
+
+static const itype_id fuel_type_battery( "battery" );
+
+// Takes the submaps the cars were parked on out of the buffer again once the test is done.
+struct parking_lot {
+    std::vector<tripoint> submaps;
+
+    ~parking_lot() {
+        for( const tripoint &sm_loc : submaps ) {
+            MAPBUFFER.remove_unused_submap( sm_loc );
+        }
+    }
+};
+
+// Puts a vehicle on a fresh submap far away from the reality bubble.
+static vehicle *park_car( parking_lot &lot, const tripoint &sm_loc, bool engine_on,
+                          const vproto_id &type = vproto_id( "car" ) )
+{
+    std::unique_ptr<submap> sm( new submap() );
+    std::unique_ptr<vehicle> veh( new vehicle( type, 100, 0 ) );
+    veh->smx = sm_loc.x;
+    veh->smy = sm_loc.y;
+    veh->smz = sm_loc.z;
+    veh->engine_on = engine_on;
+    vehicle *const result = veh.get();
+    sm->vehicles.push_back( std::move( veh ) );
+    REQUIRE( MAPBUFFER.add_submap( sm_loc, sm ) );
+    lot.submaps.push_back( sm_loc );
+    return result;
+}
+
+static bool is_active( const tripoint &sm_loc )
+{
+    return MAPBUFFER.get_active_vehicle_submaps().count( sm_loc ) != 0;
+}
+
+TEST_CASE( "off_map_vehicles_are_processed_while_running", "[vehicle][idle]" )
+{
+    const tripoint far_away = g->m.get_abs_sub() + tripoint( 1000, 1000, 0 );
+    const tripoint parked_loc = far_away;
+    const tripoint running_loc = far_away + tripoint( 1, 0, 0 );
+
+    parking_lot lot;
+    park_car( lot, parked_loc, false );
+    vehicle *const running = park_car( lot, running_loc, true );
+    CHECK_FALSE( is_active( parked_loc ) );
+    REQUIRE( is_active( running_loc ) );
+
+    g->process_vehicle_power();
+    CHECK( running->engine_on );
+    CHECK( is_active( running_loc ) );
+
+    running->engine_on = false;
+    g->process_vehicle_power();
+    CHECK_FALSE( is_active( running_loc ) );
+}
+
+TEST_CASE( "parked_solar_vehicles_charge_for_the_time_away", "[vehicle][idle]" )
+{
+    const time_point old_turn = calendar::turn;
+    const weather_type old_weather = g->weather_override;
+    calendar::turn = to_turns<int>( calendar::turn.season_length() ) + DAYS( 1 );
+    const time_point start = calendar::turn.sunrise() + 3_hours;
+    calendar::turn = to_turn<int>( start );
+    g->weather_override = WEATHER_SUNNY;
+
+    parking_lot lot;
+    const tripoint sm_loc = g->m.get_abs_sub() + tripoint( 1000, 1000, 0 );
+    vehicle *const veh = park_car( lot, sm_loc, false, vproto_id( "solar_panel_test" ) );
+    veh->update_time( start );
+    veh->discharge_battery( veh->fuel_left( fuel_type_battery ) );
+    REQUIRE( veh->fuel_left( fuel_type_battery ) == 0 );
+
+    // Solar panels only ever charged through update_time when the vehicle is in the reality
+    // bubble, so leaving parked vehicles alone outside of it doesn't lose any charge.
+    CHECK_FALSE( is_active( sm_loc ) );
+    for( int i = 0; i < 60; ++i ) {
+        calendar::turn = to_turn<int>( start + 1_minutes * ( i + 1 ) );
+        g->process_vehicle_power();
+    }
+    CHECK( veh->fuel_left( fuel_type_battery ) == 0 );
+
+    // Once it is back in the bubble it catches up on the whole hour.
+    calendar::turn = to_turn<int>( start + 1_hours );
+    veh->idle( true );
+    const int approx_battery = veh->fuel_left( fuel_type_battery ) / 100;
+    CHECK( approx_battery >= 24 );
+    CHECK( approx_battery <= 28 );
+
+    g->weather_override = old_weather;
+    calendar::turn = to_turn<int>( old_turn );
+}
+
+TEST_CASE( "vehicle_power_turn_time_with_mapbuffer_size", "[.]" )
+{
+    const tripoint origin = g->m.get_abs_sub() + tripoint( 2000, 2000, 0 );
+    const int turns = 100;
+    int stored = 0;
+    parking_lot lot;
+    for( const int target : {
+             100, 1000, 4000
+         } ) {
+        // Mostly parked vehicles with the occasional running one, like an explored world.
+        for( ; stored < target; ++stored ) {
+            park_car( lot, origin + tripoint( stored % 100, stored / 100, 0 ), stored % 100 == 0 );
+        }
+        const auto start = std::chrono::high_resolution_clock::now();
+        for( int i = 0; i < turns; ++i ) {
+            g->process_vehicle_power();
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        const long elapsed = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+        printf( "%d stored vehicles (%d running): %ld microseconds per turn.\n",
+                stored, static_cast<int>( MAPBUFFER.get_active_vehicle_submaps().size() ),
+                elapsed / turns );
+    }
+}
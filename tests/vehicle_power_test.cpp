@@ -8,6 +8,7 @@
 #include "itype.h"
 #include "calendar.h"
 #include "weather.h"
+#include "map_helpers.h"
 
 static const itype_id fuel_type_battery( "battery" );
 static const itype_id fuel_type_plut_cell( "plut_cell" );
@@ -74,3 +75,92 @@ TEST_CASE( "vehicle_power" )
         CHECK( approx_battery2 <= approx_battery1 + exp_max );
     }
 }
+
+// Plugs a jumper cable into both vehicles the way the cable item does it.
+static void connect_with_cable( vehicle &source, vehicle &target )
+{
+    const vpart_id cable_id( "jumper_cable" );
+    vehicle_part source_part( cable_id, point( 0, 0 ), item( "jumper_cable" ) );
+    source_part.target.first = g->m.getabs( target.global_pos3() );
+    source_part.target.second = g->m.getabs( target.global_pos3() );
+    REQUIRE( source.install_part( point( 0, 0 ), source_part ) >= 0 );
+
+    vehicle_part target_part( cable_id, point( 0, 0 ), item( "jumper_cable" ) );
+    target_part.target.first = g->m.getabs( source.global_pos3() );
+    target_part.target.second = g->m.getabs( source.global_pos3() );
+    REQUIRE( target.install_part( point( 0, 0 ), target_part ) >= 0 );
+}
+
+static int first_battery( const vehicle &veh )
+{
+    for( size_t p = 0; p < veh.parts.size(); ++p ) {
+        if( veh.parts[ p ].is_battery() ) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+// Charge of the batteries of the vehicle and of all the vehicles connected to it.
+static int grid_charge( const vehicle &veh )
+{
+    return veh.fuel_left( fuel_type_battery, true );
+}
+
+TEST_CASE( "vehicle_power_grid_follows_changes", "[vehicle]" )
+{
+    clear_map();
+    vehicle *first = g->m.add_vehicle( vproto_id( "solar_panel_test" ), tripoint( 10, 10, 0 ),
+                                       0, 0, 0 );
+    vehicle *second = g->m.add_vehicle( vproto_id( "solar_panel_test" ), tripoint( 20, 10, 0 ),
+                                        0, 0, 0 );
+    REQUIRE( first != nullptr );
+    REQUIRE( second != nullptr );
+    REQUIRE( first_battery( *first ) >= 0 );
+    REQUIRE( first_battery( *second ) >= 0 );
+    first->parts[ first_battery( *first ) ].ammo_set( fuel_type_battery, 100 );
+    second->parts[ first_battery( *second ) ].ammo_set( fuel_type_battery, 1000 );
+
+    // Looking at the grid caches it, so every change below has to drop it again
+    REQUIRE( grid_charge( *first ) == 100 );
+    REQUIRE( grid_charge( *second ) == 1000 );
+
+    connect_with_cable( *first, *second );
+    CHECK( grid_charge( *first ) == 1100 );
+    CHECK( grid_charge( *second ) == 1100 );
+
+    SECTION( "installing a battery on the other end" ) {
+        const int battery = second->install_part( point( 1, 0 ), vpart_id( "battery_car" ), true );
+        REQUIRE( battery >= 0 );
+        second->parts[ battery ].ammo_set( fuel_type_battery, 10 );
+        CHECK( grid_charge( *first ) == 1110 );
+    }
+
+    SECTION( "removing the cable" ) {
+        const int cable = first->part_with_feature( point( 0, 0 ), "POWER_TRANSFER", false );
+        REQUIRE( cable >= 0 );
+        first->remove_part( cable );
+        CHECK( grid_charge( *first ) == 100 );
+    }
+
+    SECTION( "destroying the battery on the other end" ) {
+        const int battery = first_battery( *second );
+        const auto destroyed = [second, battery]() {
+            return second->parts[ battery ].is_broken() || second->parts[ battery ].removed;
+        };
+        // The damage goes to a random part of the tile, so keep hitting until the battery is gone
+        for( int i = 0; i < 100 && !destroyed(); ++i ) {
+            second->damage( battery, 1000, DT_TRUE );
+        }
+        REQUIRE( destroyed() );
+        CHECK( grid_charge( *first ) == first->fuel_left( fuel_type_battery ) +
+               second->fuel_left( fuel_type_battery ) );
+    }
+
+    SECTION( "destroying the vehicle on the other end" ) {
+        g->m.destroy_vehicle( second );
+        CHECK( grid_charge( *first ) == 100 );
+    }
+
+    clear_map();
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "calendar.h"
+#include "enums.h"
+#include "rng.h"
+#include "simplexnoise.h"
+#include "weather_gen.h"
+
+struct noise_samples {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> w;
+
+    void add( float nx, float ny, float nz, float nw ) {
+        x.push_back( nx );
+        y.push_back( ny );
+        z.push_back( nz );
+        w.push_back( nw );
+    }
+};
+
+// Points spread like the ones the weather uses: fractions of the map position and turn,
+// with the seed as the last coordinate.
+static noise_samples random_samples( int count )
+{
+    noise_samples result;
+    for( int i = 0; i < count; ++i ) {
+        result.add( rng_float( -500.0, 500.0 ), rng_float( -500.0, 500.0 ),
+                    rng_float( 0.0, 5000.0 ), rng( 0, 32767 ) );
+    }
+    return result;
+}
+
+TEST_CASE( "batched_noise_matches_scalar_noise", "[weather][noise]" )
+{
+    // Not a multiple of the batch size, so the last block is a partial one
+    const int count = 1000;
+    const noise_samples samples = random_samples( count );
+    std::vector<float> batched( count );
+    raw_noise_4d_batch( samples.x.data(), samples.y.data(), samples.z.data(), samples.w.data(),
+                        batched.data(), count );
+
+    int mismatches = 0;
+    for( int i = 0; i < count; ++i ) {
+        const float scalar = raw_noise_4d( samples.x[i], samples.y[i], samples.z[i], samples.w[i] );
+        if( scalar != batched[i] ) {
+            mismatches++;
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "batched_weather_matches_single_weather", "[weather][noise]" )
+{
+    const weather_generator wgen;
+    const tripoint location( 1234, -5678, 0 );
+    const unsigned seed = 1000;
+    std::vector<time_point> times;
+    for( int hour = 0; hour < 24 * 14; ++hour ) {
+        times.push_back( calendar::time_of_cataclysm + hour * 1_hours );
+    }
+
+    const std::vector<w_point> batched = wgen.get_weather_batch( location, times, seed );
+    REQUIRE( batched.size() == times.size() );
+    for( size_t i = 0; i < times.size(); ++i ) {
+        const w_point single = wgen.get_weather( location, times[i], seed );
+        // Wind speed has a random component, everything else is determined by the noise.
+        CHECK( batched[i].temperature == single.temperature );
+        CHECK( batched[i].humidity == single.humidity );
+        CHECK( batched[i].pressure == single.pressure );
+        CHECK( batched[i].acidic == single.acidic );
+    }
+}
+
+TEST_CASE( "noise_perf", "[.]" )
+{
+    const int count = 1000000;
+    const noise_samples samples = random_samples( count );
+    std::vector<float> out( count );
+
+    const auto start1 = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < count; ++i ) {
+        out[i] = raw_noise_4d( samples.x[i], samples.y[i], samples.z[i], samples.w[i] );
+    }
+    const auto end1 = std::chrono::high_resolution_clock::now();
+    raw_noise_4d_batch( samples.x.data(), samples.y.data(), samples.z.data(), samples.w.data(),
+                        out.data(), count );
+    const auto end2 = std::chrono::high_resolution_clock::now();
+
+    const long scalar = std::chrono::duration_cast<std::chrono::microseconds>( end1 - start1 ).count();
+    const long batched = std::chrono::duration_cast<std::chrono::microseconds>( end2 - end1 ).count();
+    printf( "scalar noise: %d samples in %ld microseconds, %.0f samples per second.\n",
+            count, scalar, count * 1e6 / std::max( scalar, 1L ) );
+    printf( "batched noise: %d samples in %ld microseconds, %.0f samples per second.\n",
+            count, batched, count * 1e6 / std::max( batched, 1L ) );
+}